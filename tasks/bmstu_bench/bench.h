@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+
+namespace bmstu::bench
+{
+// Время выполнения f в миллисекундах; общий помощник DISABLED_-замеров.
+template <typename F>
+double measure_ms(F f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(
+			   std::chrono::steady_clock::now() - start)
+		.count();
+}
+}  // namespace bmstu::bench
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "hazard_pointers.h"
+
+namespace bmstu
+{
+// Неблокирующая очередь для многих производителей и потребителей по схеме
+// Майкла — Скотта: односвязный список с фиктивным узлом в голове, head и
+// tail меняются через CAS. Снятые узлы освобождаются через указатели
+// опасности, поэтому ABA и обращение к освобождённой памяти исключены.
+//
+// push_batch собирает цепочку узлов локально и подвешивает её одним CAS;
+// try_pop_batch проходит до max узлов под защитой указателей опасности и
+// снимает их одним CAS головы. Порядок FIFO сохраняется для каждого
+// производителя, а пакет одного push_batch не перемешивается с чужими.
+template <typename T>
+class concurrent_queue
+{
+	static_assert(std::is_nothrow_move_constructible_v<T>,
+				  "values are moved out after the node is already taken");
+
+	struct node
+	{
+		T* value() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(storage));
+		}
+
+		std::atomic<node*> next{nullptr};
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+   public:
+	using value_type = T;
+
+	concurrent_queue()
+	{
+		node* dummy = new node;
+		head_.store(dummy, std::memory_order_relaxed);
+		tail_.store(dummy, std::memory_order_relaxed);
+	}
+
+	concurrent_queue(const concurrent_queue& other) = delete;
+	concurrent_queue& operator=(const concurrent_queue& other) = delete;
+
+	// Вызывается, когда с очередью больше никто не работает.
+	~concurrent_queue()
+	{
+		node* current = head_.load(std::memory_order_acquire);
+		node* next = current->next.load(std::memory_order_relaxed);
+		delete current;
+		while (next != nullptr)
+		{
+			current = next;
+			next = current->next.load(std::memory_order_relaxed);
+			std::destroy_at(current->value());
+			delete current;
+		}
+	}
+
+	void push(T value)
+	{
+		node* n = create_node_(std::move(value));
+		link_chain_(n, n);
+	}
+
+	// Добавляет [first, last) одним CAS хвоста.
+	template <typename It>
+	void push_batch(It first, It last)
+	{
+		node* head = nullptr;
+		node* tail = nullptr;
+		try
+		{
+			for (; first != last; ++first)
+			{
+				node* n = create_node_(*first);
+				if (head == nullptr)
+				{
+					head = n;
+				}
+				else
+				{
+					tail->next.store(n, std::memory_order_relaxed);
+				}
+				tail = n;
+			}
+		}
+		catch (...)
+		{
+			destroy_chain_(head);
+			throw;
+		}
+		if (head != nullptr)
+		{
+			link_chain_(head, tail);
+		}
+	}
+
+	bool try_pop(T& value)
+	{
+		return try_pop_batch(&value, 1) == 1;
+	}
+
+	// Снимает до max элементов, записывает их в out и возвращает число
+	// снятых; 0 — очередь была пуста.
+	template <typename OutIt>
+	size_t try_pop_batch(OutIt out, size_t max)
+	{
+		if (max == 0)
+		{
+			return 0;
+		}
+		detail::hazard_domain::record* r = detail::this_thread_hazards();
+		while (true)
+		{
+			node* head = detail::protect(head_, r, 0);
+			node* last = head;
+			size_t taken = 0;
+			bool moved = false;
+			while (taken < max)
+			{
+				node* next = last->next.load(std::memory_order_acquire);
+				if (next == nullptr)
+				{
+					break;
+				}
+				// Пока голова не сдвинулась, next не мог быть удалён: его
+				// удаляют только после того, как голова пройдёт мимо head.
+				r->hazards[1 + taken % 2].store(next,
+												std::memory_order_seq_cst);
+				if (head_.load(std::memory_order_seq_cst) != head)
+				{
+					moved = true;
+					break;
+				}
+				// Хвост не должен остаться на узле, который мы удалим.
+				node* tail = tail_.load(std::memory_order_acquire);
+				if (tail == last)
+				{
+					tail_.compare_exchange_strong(tail, next,
+												  std::memory_order_release,
+												  std::memory_order_relaxed);
+				}
+				last = next;
+				++taken;
+			}
+			if (moved)
+			{
+				continue;
+			}
+			if (taken == 0)
+			{
+				clear_hazards_(r);
+				return 0;
+			}
+			node* expected = head;
+			if (!head_.compare_exchange_strong(expected, last,
+											   std::memory_order_acq_rel,
+											   std::memory_order_relaxed))
+			{
+				continue;
+			}
+			// Узлы между head и last теперь наши; last стал фиктивным и
+			// защищён указателем опасности, пока из него забирают значение.
+			node* current = head->next.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < taken; ++i)
+			{
+				T* stored = current->value();
+				*out = std::move(*stored);
+				++out;
+				std::destroy_at(stored);
+				current = current->next.load(std::memory_order_relaxed);
+			}
+			clear_hazards_(r);
+			current = head;
+			for (size_t i = 0; i < taken; ++i)
+			{
+				node* next = current->next.load(std::memory_order_relaxed);
+				detail::hazard_domain::instance().retire(r, current,
+														 &delete_node_);
+				current = next;
+			}
+			return taken;
+		}
+	}
+
+	// Мгновенный снимок: к моменту возврата ответ может устареть.
+	bool empty() const
+	{
+		detail::hazard_domain::record* r = detail::this_thread_hazards();
+		node* head = detail::protect(head_, r, 0);
+		const bool result =
+			head->next.load(std::memory_order_acquire) == nullptr;
+		r->hazards[0].store(nullptr, std::memory_order_release);
+		return result;
+	}
+
+   private:
+	template <typename U>
+	static node* create_node_(U&& value)
+	{
+		node* n = new node;
+		try
+		{
+			std::construct_at(n->value(), std::forward<U>(value));
+		}
+		catch (...)
+		{
+			delete n;
+			throw;
+		}
+		return n;
+	}
+
+	static void destroy_chain_(node* current) noexcept
+	{
+		while (current != nullptr)
+		{
+			node* next = current->next.load(std::memory_order_relaxed);
+			std::destroy_at(current->value());
+			delete current;
+			current = next;
+		}
+	}
+
+	// Вызывается из домена для узлов, значения которых уже забраны.
+	static void delete_node_(void* p) { delete static_cast<node*>(p); }
+
+	static void clear_hazards_(detail::hazard_domain::record* r) noexcept
+	{
+		for (auto& slot : r->hazards)
+		{
+			slot.store(nullptr, std::memory_order_release);
+		}
+	}
+
+	void link_chain_(node* first, node* last)
+	{
+		detail::hazard_domain::record* r = detail::this_thread_hazards();
+		while (true)
+		{
+			node* tail = detail::protect(tail_, r, 0);
+			node* next = tail->next.load(std::memory_order_acquire);
+			if (next != nullptr)
+			{
+				// Хвост отстал: помогаем его сдвинуть.
+				tail_.compare_exchange_weak(tail, next,
+											std::memory_order_release,
+											std::memory_order_relaxed);
+				continue;
+			}
+			node* expected = nullptr;
+			if (tail->next.compare_exchange_weak(expected, first,
+												 std::memory_order_release,
+												 std::memory_order_relaxed))
+			{
+				tail_.compare_exchange_strong(tail, last,
+											  std::memory_order_release,
+											  std::memory_order_relaxed);
+				break;
+			}
+		}
+		r->hazards[0].store(nullptr, std::memory_order_release);
+	}
+
+	alignas(64) std::atomic<node*> head_;
+	alignas(64) std::atomic<node*> tail_;
+};
+}  // namespace bmstu
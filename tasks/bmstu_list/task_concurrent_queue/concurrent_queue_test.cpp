@@ -0,0 +1,308 @@
+#include "concurrent_queue.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bmstu_list.h"
+
+TEST(ConcurrentQueueTest, SingleThreadFifo)
+{
+	bmstu::concurrent_queue<int> queue;
+	int value = 0;
+	ASSERT_TRUE(queue.empty());
+	ASSERT_FALSE(queue.try_pop(value));
+	for (int i = 0; i < 100; ++i)
+	{
+		queue.push(i);
+	}
+	ASSERT_FALSE(queue.empty());
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_TRUE(queue.try_pop(value));
+		ASSERT_EQ(value, i);
+	}
+	ASSERT_TRUE(queue.empty());
+	ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(ConcurrentQueueTest, Batches)
+{
+	bmstu::concurrent_queue<std::string> queue;
+	const std::vector<std::string> first{"a", "b", "c"};
+	const std::vector<std::string> second{"d", "e"};
+	queue.push_batch(first.begin(), first.end());
+	queue.push_batch(second.begin(), second.begin());
+	queue.push("x");
+	queue.push_batch(second.begin(), second.end());
+
+	std::vector<std::string> out(10);
+	ASSERT_EQ(queue.try_pop_batch(out.begin(), 2), 2u);
+	ASSERT_EQ(out[0], "a");
+	ASSERT_EQ(out[1], "b");
+	ASSERT_EQ(queue.try_pop_batch(out.begin(), 10), 4u);
+	ASSERT_EQ(out[0], "c");
+	ASSERT_EQ(out[1], "x");
+	ASSERT_EQ(out[3], "e");
+	ASSERT_EQ(queue.try_pop_batch(out.begin(), 10), 0u);
+	ASSERT_EQ(queue.try_pop_batch(out.begin(), 0), 0u);
+}
+
+TEST(ConcurrentQueueTest, DestructorReleasesValues)
+{
+	auto tracked = std::make_shared<int>(0);
+	{
+		bmstu::concurrent_queue<std::shared_ptr<int>> queue;
+		for (int i = 0; i < 10; ++i)
+		{
+			queue.push(tracked);
+		}
+		std::shared_ptr<int> popped;
+		ASSERT_TRUE(queue.try_pop(popped));
+		ASSERT_EQ(tracked.use_count(), 11);
+	}
+	ASSERT_EQ(tracked.use_count(), 1);
+}
+
+TEST(ConcurrentQueueTest, ManyProducersManyConsumers)
+{
+	constexpr int kProducers = 4;
+	constexpr int kConsumers = 4;
+	constexpr int kPerProducer = 20'000;
+	bmstu::concurrent_queue<std::unique_ptr<int64_t>> queue;
+	std::atomic<int> consumed{0};
+	std::vector<std::vector<int64_t>> seen(kConsumers);
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < kProducers; ++p)
+	{
+		threads.emplace_back(
+			[&queue, p]
+			{
+				for (int i = 0; i < kPerProducer; i += 4)
+				{
+					const int64_t base = int64_t{p} * kPerProducer + i;
+					if (i % 8 == 0)
+					{
+						queue.push(std::make_unique<int64_t>(base));
+						queue.push(std::make_unique<int64_t>(base + 1));
+						queue.push(std::make_unique<int64_t>(base + 2));
+						queue.push(std::make_unique<int64_t>(base + 3));
+					}
+					else
+					{
+						std::vector<std::unique_ptr<int64_t>> batch;
+						for (int k = 0; k < 4; ++k)
+						{
+							batch.push_back(
+								std::make_unique<int64_t>(base + k));
+						}
+						queue.push_batch(std::make_move_iterator(batch.begin()),
+										 std::make_move_iterator(batch.end()));
+					}
+				}
+			});
+	}
+	for (int c = 0; c < kConsumers; ++c)
+	{
+		threads.emplace_back(
+			[&, c]
+			{
+				std::vector<std::unique_ptr<int64_t>> out(3);
+				while (consumed.load() < kProducers * kPerProducer)
+				{
+					const size_t n =
+						queue.try_pop_batch(out.begin(), 1 + c % 3);
+					for (size_t i = 0; i < n; ++i)
+					{
+						seen[c].push_back(*out[i]);
+					}
+					consumed.fetch_add(static_cast<int>(n));
+					if (n == 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	std::vector<int> hits(kProducers * kPerProducer);
+	for (const auto& values : seen)
+	{
+		// Каждый потребитель видит значения одного производителя по
+		// возрастанию.
+		std::vector<int64_t> last(kProducers, -1);
+		for (int64_t v : values)
+		{
+			++hits[v];
+			const int64_t producer = v / kPerProducer;
+			ASSERT_GT(v, last[producer]);
+			last[producer] = v;
+		}
+	}
+	for (int count : hits)
+	{
+		ASSERT_EQ(count, 1);
+	}
+	ASSERT_TRUE(queue.empty());
+}
+
+namespace
+{
+// Так очередь работает сейчас: bmstu::list под мьютексом.
+template <typename T>
+class locked_list_queue
+{
+   public:
+	void push(const T& value)
+	{
+		std::lock_guard lock(mutex_);
+		list_.push_back(value);
+	}
+
+	bool try_pop(T& value)
+	{
+		std::lock_guard lock(mutex_);
+		if (list_.empty())
+		{
+			return false;
+		}
+		value = std::move(list_.front());
+		list_.pop_front();
+		return true;
+	}
+
+   private:
+	std::mutex mutex_;
+	bmstu::list<T> list_;
+};
+
+template <typename Push, typename Pop>
+double run_throughput(int producers, int consumers, int64_t total, Push push,
+					  Pop pop)
+{
+	std::atomic<int64_t> consumed{0};
+	std::atomic<bool> start{false};
+	std::vector<std::thread> threads;
+	const int64_t per_producer = total / producers;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				while (!start.load())
+				{
+					std::this_thread::yield();
+				}
+				push(per_producer);
+			});
+	}
+	for (int c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				while (!start.load())
+				{
+					std::this_thread::yield();
+				}
+				while (consumed.load(std::memory_order_relaxed) <
+					   per_producer * producers)
+				{
+					const int64_t n = pop();
+					if (n == 0)
+					{
+						std::this_thread::yield();
+					}
+					consumed.fetch_add(n, std::memory_order_relaxed);
+				}
+			});
+	}
+	const auto begin = std::chrono::steady_clock::now();
+	start.store(true);
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+	const double seconds = std::chrono::duration<double>(
+							   std::chrono::steady_clock::now() - begin)
+							   .count();
+	return static_cast<double>(per_producer * producers) / seconds / 1e6;
+}
+}  // namespace
+
+TEST(ConcurrentQueueBench, DISABLED_Throughput)
+{
+	constexpr int64_t kTotal = 2'000'000;
+	constexpr size_t kBatch = 32;
+	std::cout << "producers/consumers: M items/s for mutex+bmstu::list, "
+				 "concurrent_queue, concurrent_queue batch "
+			  << kBatch << "\n";
+	for (int threads : {1, 2, 4, 8, 16})
+	{
+		locked_list_queue<int64_t> locked;
+		const double locked_rate = run_throughput(
+			threads, threads, kTotal,
+			[&](int64_t n)
+			{
+				for (int64_t i = 0; i < n; ++i)
+				{
+					locked.push(i);
+				}
+			},
+			[&]
+			{
+				int64_t value;
+				return int64_t{locked.try_pop(value)};
+			});
+
+		bmstu::concurrent_queue<int64_t> queue;
+		const double queue_rate = run_throughput(
+			threads, threads, kTotal,
+			[&](int64_t n)
+			{
+				for (int64_t i = 0; i < n; ++i)
+				{
+					queue.push(i);
+				}
+			},
+			[&]
+			{
+				int64_t value;
+				return int64_t{queue.try_pop(value)};
+			});
+
+		bmstu::concurrent_queue<int64_t> batched;
+		const double batched_rate = run_throughput(
+			threads, threads, kTotal,
+			[&](int64_t n)
+			{
+				int64_t values[kBatch] = {};
+				for (int64_t i = 0; i < n; i += kBatch)
+				{
+					const auto count = static_cast<size_t>(
+						std::min<int64_t>(kBatch, n - i));
+					batched.push_batch(values, values + count);
+				}
+			},
+			[&]
+			{
+				int64_t values[kBatch];
+				return static_cast<int64_t>(
+					batched.try_pop_batch(values, kBatch));
+			});
+
+		std::cout << threads << "/" << threads << ": " << locked_rate << ", "
+				  << queue_rate << ", " << batched_rate << "\n";
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace bmstu
+{
+namespace detail
+{
+// Указатели опасности (hazard pointers, Michael 2004). Поток публикует в
+// своих слотах адреса узлов, которые сейчас читает; удалённый из структуры
+// узел не освобождается сразу, а попадает в список отложенных и удаляется,
+// когда его адреса нет ни в одном слоте. Домен один на процесс: записи
+// потоков переиспользуются после завершения потока, отложенные узлы
+// переходят к следующему владельцу записи.
+class hazard_domain
+{
+   public:
+	static constexpr size_t kSlots = 3;
+
+	struct retired_ptr
+	{
+		void* ptr;
+		void (*deleter)(void*);
+	};
+
+	struct alignas(64) record
+	{
+		std::atomic<const void*> hazards[kSlots] = {};
+		std::atomic<bool> active{false};
+		record* next = nullptr;
+		std::vector<retired_ptr> retired;
+	};
+
+	static hazard_domain& instance()
+	{
+		static hazard_domain domain;
+		return domain;
+	}
+
+	hazard_domain(const hazard_domain&) = delete;
+	hazard_domain& operator=(const hazard_domain&) = delete;
+
+	~hazard_domain()
+	{
+		record* r = head_.load(std::memory_order_acquire);
+		while (r != nullptr)
+		{
+			record* next = r->next;
+			for (const retired_ptr& p : r->retired)
+			{
+				p.deleter(p.ptr);
+			}
+			delete r;
+			r = next;
+		}
+	}
+
+	record* acquire()
+	{
+		for (record* r = head_.load(std::memory_order_acquire); r != nullptr;
+			 r = r->next)
+		{
+			bool expected = false;
+			if (!r->active.load(std::memory_order_relaxed) &&
+				r->active.compare_exchange_strong(expected, true,
+												  std::memory_order_acq_rel))
+			{
+				return r;
+			}
+		}
+		record* r = new record;
+		r->active.store(true, std::memory_order_relaxed);
+		record* old = head_.load(std::memory_order_relaxed);
+		do
+		{
+			r->next = old;
+		} while (!head_.compare_exchange_weak(old, r, std::memory_order_release,
+											  std::memory_order_relaxed));
+		record_count_.fetch_add(1, std::memory_order_relaxed);
+		return r;
+	}
+
+	void release(record* r) noexcept
+	{
+		for (auto& slot : r->hazards)
+		{
+			slot.store(nullptr, std::memory_order_release);
+		}
+		r->active.store(false, std::memory_order_release);
+	}
+
+	// Узел уже недостижим из структуры; deleter вызовется, когда его не
+	// будет ни в одном слоте.
+	void retire(record* r, void* ptr, void (*deleter)(void*))
+	{
+		r->retired.push_back({ptr, deleter});
+		const size_t threshold = std::max<size_t>(
+			64, 2 * kSlots * record_count_.load(std::memory_order_relaxed));
+		if (r->retired.size() >= threshold)
+		{
+			scan_(r);
+		}
+	}
+
+   private:
+	hazard_domain() = default;
+
+	void scan_(record* owner)
+	{
+		std::vector<const void*> protected_ptrs;
+		for (record* r = head_.load(std::memory_order_acquire); r != nullptr;
+			 r = r->next)
+		{
+			for (const auto& slot : r->hazards)
+			{
+				if (const void* p = slot.load(std::memory_order_seq_cst))
+				{
+					protected_ptrs.push_back(p);
+				}
+			}
+		}
+		std::sort(protected_ptrs.begin(), protected_ptrs.end());
+		auto keep = owner->retired.begin();
+		for (auto it = owner->retired.begin(); it != owner->retired.end();
+			 ++it)
+		{
+			if (std::binary_search(protected_ptrs.begin(),
+								   protected_ptrs.end(), it->ptr))
+			{
+				*keep++ = *it;
+			}
+			else
+			{
+				it->deleter(it->ptr);
+			}
+		}
+		owner->retired.erase(keep, owner->retired.end());
+	}
+
+	std::atomic<record*> head_{nullptr};
+	std::atomic<size_t> record_count_{0};
+};
+
+// Запись текущего потока; возвращается в домен при завершении потока.
+inline hazard_domain::record* this_thread_hazards()
+{
+	struct holder
+	{
+		hazard_domain::record* r = hazard_domain::instance().acquire();
+
+		~holder() { hazard_domain::instance().release(r); }
+	};
+	thread_local holder h;
+	return h.r;
+}
+
+// Публикует src в слоте и перечитывает его, пока значение не устоится:
+// после выхода узел не освободят, пока слот не очищен.
+template <typename Node>
+Node* protect(const std::atomic<Node*>& src,
+			  hazard_domain::record* r,
+			  size_t slot) noexcept
+{
+	Node* p = src.load(std::memory_order_relaxed);
+	while (true)
+	{
+		r->hazards[slot].store(p, std::memory_order_seq_cst);
+		Node* q = src.load(std::memory_order_seq_cst);
+		if (q == p)
+		{
+			return p;
+		}
+		p = q;
+	}
+}
+}  // namespace detail
+}  // namespace bmstu
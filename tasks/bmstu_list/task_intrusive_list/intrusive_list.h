@@ -0,0 +1,385 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include "abstract_iterator.h"
+
+namespace bmstu
+{
+template <typename T, typename Hook>
+class intrusive_list;
+
+// Звено интрузивного списка. Элемент наследует его и так сам становится
+// узлом: next/prev лежат внутри объекта, список ничего не выделяет. Tag
+// различает звенья, если объект должен стоять в нескольких списках сразу.
+// Копия объекта не наследует связей, а разрушение объекта выводит его из
+// списка.
+template <typename Tag = void>
+class list_hook
+{
+	template <typename T, typename Hook>
+	friend class intrusive_list;
+
+   public:
+	list_hook() noexcept = default;
+
+	list_hook(const list_hook&) noexcept {}
+
+	list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+	~list_hook() { unlink(); }
+
+	bool is_linked() const noexcept { return next_ != nullptr; }
+
+	// Выводит элемент из списка, в котором он стоит, за O(1).
+	void unlink() noexcept
+	{
+		if (next_ != nullptr)
+		{
+			prev_->next_ = next_;
+			next_->prev_ = prev_;
+			next_ = nullptr;
+			prev_ = nullptr;
+		}
+	}
+
+   private:
+	list_hook* next_ = nullptr;
+	list_hook* prev_ = nullptr;
+};
+
+// Интрузивный двусвязный список над элементами, унаследованными от Hook.
+// Список не владеет элементами: они живут там, где их создали, и должны
+// пережить своё пребывание в списке (или выйти из него сами). Элемент
+// можно вынуть за O(1) и без списка, через unlink(), поэтому размер не
+// хранится: size() — O(n), empty() — O(1).
+template <typename T, typename Hook = list_hook<>>
+class intrusive_list
+{
+	static_assert(std::is_base_of_v<Hook, T>, "T must derive from Hook");
+
+	template <bool Const>
+	class basic_iterator final
+		: public abstract_iterator<basic_iterator<Const>,
+								   std::conditional_t<Const, const T, T>,
+								   std::bidirectional_iterator_tag>
+	{
+		using base = abstract_iterator<basic_iterator<Const>,
+									   std::conditional_t<Const, const T, T>,
+									   std::bidirectional_iterator_tag>;
+		friend class intrusive_list;
+
+	   public:
+		using typename base::difference_type;
+		using typename base::pointer;
+		using typename base::reference;
+
+		basic_iterator() = default;
+
+		explicit basic_iterator(Hook* node) noexcept : node_(node) {}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(node_);
+		}
+
+		reference operator*() const override { return static_cast<T&>(*node_); }
+
+		pointer operator->() const override { return &**this; }
+
+		basic_iterator& operator++() override
+		{
+			node_ = next_(node_);
+			return *this;
+		}
+
+		basic_iterator operator++(int) override
+		{
+			basic_iterator tmp = *this;
+			node_ = next_(node_);
+			return tmp;
+		}
+
+		basic_iterator& operator--() override
+		{
+			node_ = prev_(node_);
+			return *this;
+		}
+
+		basic_iterator operator--(int) override
+		{
+			basic_iterator tmp = *this;
+			node_ = prev_(node_);
+			return tmp;
+		}
+
+		basic_iterator& operator+=(const difference_type& n) override
+		{
+			for (difference_type i = 0; i < n; ++i)
+			{
+				node_ = next_(node_);
+			}
+			for (difference_type i = 0; i > n; --i)
+			{
+				node_ = prev_(node_);
+			}
+			return *this;
+		}
+
+		basic_iterator& operator-=(const difference_type& n) override
+		{
+			return *this += -n;
+		}
+
+		basic_iterator operator+(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		basic_iterator operator-(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		// Число шагов вперёд от other до *this; other не должен стоять после
+		// *this.
+		difference_type operator-(const basic_iterator& other) const override
+		{
+			difference_type count = 0;
+			for (Hook* it = other.node_; it != node_; it = next_(it))
+			{
+				++count;
+			}
+			return count;
+		}
+
+		bool operator==(const basic_iterator& other) const override
+		{
+			return node_ == other.node_;
+		}
+
+		bool operator!=(const basic_iterator& other) const override
+		{
+			return node_ != other.node_;
+		}
+
+		explicit operator bool() const override { return node_ != nullptr; }
+
+	   private:
+		Hook* node_ = nullptr;
+	};
+
+   public:
+	using value_type = T;
+	using hook_type = Hook;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	intrusive_list() noexcept { reset_links_(); }
+
+	intrusive_list(const intrusive_list& other) = delete;
+	intrusive_list& operator=(const intrusive_list& other) = delete;
+
+	intrusive_list(intrusive_list&& other) noexcept : intrusive_list()
+	{
+		swap(other);
+	}
+
+	intrusive_list& operator=(intrusive_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			swap(other);
+		}
+		return *this;
+	}
+
+	// Элементы остаются жить, но выходят из списка.
+	~intrusive_list() { clear(); }
+
+	bool empty() const noexcept { return sentinel_.next_ == &sentinel_; }
+
+	size_t size() const noexcept
+	{
+		return static_cast<size_t>(end() - begin());
+	}
+
+	void clear() noexcept
+	{
+		list_hook_base* current = sentinel_.next_;
+		while (current != &sentinel_)
+		{
+			list_hook_base* next = current->next_;
+			current->next_ = nullptr;
+			current->prev_ = nullptr;
+			current = next;
+		}
+		reset_links_();
+	}
+
+	void swap(intrusive_list& other) noexcept
+	{
+		const bool was_empty = empty();
+		const bool other_was_empty = other.empty();
+		std::swap(sentinel_.next_, other.sentinel_.next_);
+		std::swap(sentinel_.prev_, other.sentinel_.prev_);
+		fix_links_(other_was_empty);
+		other.fix_links_(was_empty);
+	}
+
+	friend void swap(intrusive_list& l, intrusive_list& r) noexcept
+	{
+		l.swap(r);
+	}
+
+	iterator begin() noexcept { return iterator(next_(&sentinel_)); }
+
+	iterator end() noexcept { return iterator(&sentinel_); }
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(next_(end_node_()));
+	}
+
+	const_iterator end() const noexcept { return const_iterator(end_node_()); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+	// Итератор на элемент, стоящий в этом списке.
+	iterator iterator_to(T& value) noexcept
+	{
+		return iterator(static_cast<Hook*>(&value));
+	}
+
+	const_iterator iterator_to(const T& value) const noexcept
+	{
+		return const_iterator(
+			const_cast<Hook*>(static_cast<const Hook*>(&value)));
+	}
+
+	T& front() noexcept { return *begin(); }
+
+	const T& front() const noexcept { return *begin(); }
+
+	T& back() noexcept { return *--end(); }
+
+	const T& back() const noexcept { return *--end(); }
+
+	// Элемент не должен стоять в другом списке с тем же звеном.
+	void push_back(T& value) noexcept { insert(cend(), value); }
+
+	void push_front(T& value) noexcept { insert(cbegin(), value); }
+
+	iterator insert(const_iterator pos, T& value) noexcept
+	{
+		list_hook_base* n = static_cast<Hook*>(&value);
+		list_hook_base* at = pos.node_;
+		n->next_ = at;
+		n->prev_ = at->prev_;
+		at->prev_->next_ = n;
+		at->prev_ = n;
+		return iterator(static_cast<Hook*>(&value));
+	}
+
+	// Выводит элемент из списка и возвращает итератор на следующий.
+	iterator erase(const_iterator pos) noexcept
+	{
+		Hook* next = next_(pos.node_);
+		pos.node_->unlink();
+		return iterator(next);
+	}
+
+	void pop_front() noexcept { erase(cbegin()); }
+
+	void pop_back() noexcept { erase(--cend()); }
+
+	// Переносит все элементы other перед pos за O(1).
+	void splice(const_iterator pos, intrusive_list& other) noexcept
+	{
+		if (other.empty())
+		{
+			return;
+		}
+		list_hook_base* head = other.sentinel_.next_;
+		list_hook_base* tail = other.sentinel_.prev_;
+		other.reset_links_();
+		list_hook_base* at = pos.node_;
+		head->prev_ = at->prev_;
+		tail->next_ = at;
+		at->prev_->next_ = head;
+		at->prev_ = tail;
+	}
+
+	friend bool operator==(const intrusive_list& l, const intrusive_list& r)
+	{
+		auto li = l.begin();
+		auto ri = r.begin();
+		for (; li != l.end() && ri != r.end(); ++li, ++ri)
+		{
+			if (!(*li == *ri))
+			{
+				return false;
+			}
+		}
+		return li == l.end() && ri == r.end();
+	}
+
+	friend std::ostream& operator<<(std::ostream& os,
+									const intrusive_list& other)
+	{
+		os << "{";
+		for (auto it = other.begin(); it != other.end(); ++it)
+		{
+			if (it != other.begin())
+			{
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os << "}";
+	}
+
+   private:
+	using list_hook_base = Hook;
+
+	// Сторож — само звено без элемента; наружу он виден только как end().
+	static Hook* next_(Hook* node) noexcept
+	{
+		return static_cast<Hook*>(node->next_);
+	}
+
+	static Hook* prev_(Hook* node) noexcept
+	{
+		return static_cast<Hook*>(node->prev_);
+	}
+
+	Hook* end_node_() const noexcept { return const_cast<Hook*>(&sentinel_); }
+
+	void reset_links_() noexcept
+	{
+		sentinel_.next_ = &sentinel_;
+		sentinel_.prev_ = &sentinel_;
+	}
+
+	// После обмена голова и хвост смотрят на сторожа чужого списка.
+	void fix_links_(bool was_empty) noexcept
+	{
+		if (was_empty)
+		{
+			reset_links_();
+			return;
+		}
+		sentinel_.next_->prev_ = &sentinel_;
+		sentinel_.prev_->next_ = &sentinel_;
+	}
+
+	Hook sentinel_;
+};
+}  // namespace bmstu
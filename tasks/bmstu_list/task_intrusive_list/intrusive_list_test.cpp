@@ -0,0 +1,281 @@
+#include "intrusive_list.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "bmstu_list.h"
+
+namespace
+{
+struct ready_tag;
+struct timer_tag;
+
+struct task : bmstu::list_hook<ready_tag>, bmstu::list_hook<timer_tag>
+{
+	explicit task(int id) : id(id) {}
+
+	bool operator==(const task& other) const { return id == other.id; }
+
+	friend std::ostream& operator<<(std::ostream& os, const task& t)
+	{
+		return os << t.id;
+	}
+
+	int id;
+};
+
+using ready_queue = bmstu::intrusive_list<task, bmstu::list_hook<ready_tag>>;
+using timer_queue = bmstu::intrusive_list<task, bmstu::list_hook<timer_tag>>;
+
+template <typename List>
+std::vector<int> ids(const List& list)
+{
+	std::vector<int> result;
+	for (const task& t : list)
+	{
+		result.push_back(t.id);
+	}
+	return result;
+}
+}  // namespace
+
+TEST(IntrusiveListTest, Empty)
+{
+	ready_queue queue;
+	ASSERT_TRUE(queue.empty());
+	ASSERT_EQ(queue.size(), 0u);
+	ASSERT_EQ(queue.begin(), queue.end());
+	ASSERT_EQ(queue.cbegin(), queue.cend());
+}
+
+TEST(IntrusiveListTest, PushAndIterate)
+{
+	task a(1), b(2), c(3);
+	ready_queue queue;
+	queue.push_back(b);
+	queue.push_back(c);
+	queue.push_front(a);
+	ASSERT_EQ(queue.size(), 3u);
+	ASSERT_EQ(ids(queue), (std::vector<int>{1, 2, 3}));
+	ASSERT_EQ(&queue.front(), &a);
+	ASSERT_EQ(&queue.back(), &c);
+	ASSERT_EQ((queue.begin() + 2)->id, 3);
+	ASSERT_EQ(queue.end() - queue.begin(), 3);
+	ASSERT_EQ((--queue.end())->id, 3);
+	std::stringstream out;
+	out << queue;
+	ASSERT_EQ(out.str(), "{1, 2, 3}");
+}
+
+TEST(IntrusiveListTest, SelfUnlink)
+{
+	task a(1), b(2), c(3);
+	ready_queue queue;
+	queue.push_back(a);
+	queue.push_back(b);
+	queue.push_back(c);
+	ASSERT_TRUE(static_cast<bmstu::list_hook<ready_tag>&>(b).is_linked());
+	static_cast<bmstu::list_hook<ready_tag>&>(b).unlink();
+	ASSERT_FALSE(static_cast<bmstu::list_hook<ready_tag>&>(b).is_linked());
+	ASSERT_EQ(ids(queue), (std::vector<int>{1, 3}));
+	{
+		task temporary(4);
+		queue.insert(queue.iterator_to(c), temporary);
+		ASSERT_EQ(ids(queue), (std::vector<int>{1, 4, 3}));
+	}
+	// Разрушенный элемент сам вышел из очереди.
+	ASSERT_EQ(ids(queue), (std::vector<int>{1, 3}));
+}
+
+TEST(IntrusiveListTest, TwoHooks)
+{
+	task a(1), b(2), c(3);
+	ready_queue ready;
+	timer_queue timers;
+	ready.push_back(a);
+	ready.push_back(b);
+	ready.push_back(c);
+	timers.push_back(c);
+	timers.push_back(a);
+	ASSERT_EQ(ids(ready), (std::vector<int>{1, 2, 3}));
+	ASSERT_EQ(ids(timers), (std::vector<int>{3, 1}));
+	ready.erase(ready.iterator_to(c));
+	ASSERT_EQ(ids(ready), (std::vector<int>{1, 2}));
+	ASSERT_EQ(ids(timers), (std::vector<int>{3, 1}));
+}
+
+TEST(IntrusiveListTest, EraseAndPop)
+{
+	std::vector<task> tasks;
+	for (int i = 0; i < 6; ++i)
+	{
+		tasks.emplace_back(i);
+	}
+	ready_queue queue;
+	for (task& t : tasks)
+	{
+		queue.push_back(t);
+	}
+	auto it = queue.erase(queue.cbegin() + 2);
+	ASSERT_EQ(it->id, 3);
+	queue.pop_front();
+	queue.pop_back();
+	ASSERT_EQ(ids(queue), (std::vector<int>{1, 3, 4}));
+	queue.clear();
+	ASSERT_TRUE(queue.empty());
+	for (task& t : tasks)
+	{
+		ASSERT_FALSE(static_cast<bmstu::list_hook<ready_tag>&>(t).is_linked());
+	}
+}
+
+TEST(IntrusiveListTest, CopyOfElementIsNotLinked)
+{
+	task a(1);
+	ready_queue queue;
+	queue.push_back(a);
+	task copy(a);
+	ASSERT_FALSE(static_cast<bmstu::list_hook<ready_tag>&>(copy).is_linked());
+	copy = a;
+	ASSERT_FALSE(static_cast<bmstu::list_hook<ready_tag>&>(copy).is_linked());
+	ASSERT_EQ(queue.size(), 1u);
+}
+
+TEST(IntrusiveListTest, MoveSwapSplice)
+{
+	task a(1), b(2), c(3), d(4);
+	ready_queue first;
+	first.push_back(a);
+	first.push_back(b);
+	ready_queue second(std::move(first));
+	ASSERT_TRUE(first.empty());
+	ASSERT_EQ(ids(second), (std::vector<int>{1, 2}));
+
+	first.push_back(c);
+	swap(first, second);
+	ASSERT_EQ(ids(first), (std::vector<int>{1, 2}));
+	ASSERT_EQ(ids(second), (std::vector<int>{3}));
+
+	second.push_back(d);
+	first.splice(first.cbegin() + 1, second);
+	ASSERT_TRUE(second.empty());
+	ASSERT_EQ(ids(first), (std::vector<int>{1, 3, 4, 2}));
+	ASSERT_EQ((--first.end())->id, 2);
+
+	second = std::move(first);
+	ASSERT_TRUE(first.empty());
+	ASSERT_EQ(ids(second), (std::vector<int>{1, 3, 4, 2}));
+}
+
+namespace
+{
+using bmstu::bench::measure_ms;
+
+struct sched_task : bmstu::list_hook<>
+{
+	uint64_t runs = 0;
+	bool waiting = false;
+	// Для bmstu::list задача помнит свой узел, чтобы переносить его splice.
+	bmstu::list<sched_task*>::const_iterator where;
+};
+}  // namespace
+
+TEST(IntrusiveListBench, DISABLED_SchedulerChurn)
+{
+	// Планировщик: задача с головы очереди выполняется и либо встаёт в
+	// хвост, либо засыпает; каждый такт будится случайная задача.
+	constexpr size_t kTasks = 10'000;
+	constexpr size_t kTicks = 20'000'000;
+
+	std::vector<sched_task> intrusive_tasks(kTasks);
+	bmstu::intrusive_list<sched_task> ready;
+	bmstu::intrusive_list<sched_task> waiting;
+	for (sched_task& t : intrusive_tasks)
+	{
+		ready.push_back(t);
+	}
+	std::mt19937 gen(11);
+	const double intrusive_ms = measure_ms(
+		[&]
+		{
+			for (size_t tick = 0; tick < kTicks; ++tick)
+			{
+				if (!ready.empty())
+				{
+					sched_task& t = ready.front();
+					ready.pop_front();
+					++t.runs;
+					if (gen() % 4 == 0)
+					{
+						t.waiting = true;
+						waiting.push_back(t);
+					}
+					else
+					{
+						ready.push_back(t);
+					}
+				}
+				sched_task& woken = intrusive_tasks[gen() % kTasks];
+				if (woken.waiting)
+				{
+					woken.waiting = false;
+					woken.unlink();
+					ready.push_back(woken);
+				}
+			}
+		});
+
+	std::vector<sched_task> list_tasks(kTasks);
+	bmstu::list<sched_task*> list_ready;
+	bmstu::list<sched_task*> list_waiting;
+	for (sched_task& t : list_tasks)
+	{
+		list_ready.push_back(&t);
+		t.where = --list_ready.cend();
+	}
+	gen.seed(11);
+	const double list_ms = measure_ms(
+		[&]
+		{
+			for (size_t tick = 0; tick < kTicks; ++tick)
+			{
+				if (!list_ready.empty())
+				{
+					sched_task& t = *list_ready.front();
+					++t.runs;
+					if (gen() % 4 == 0)
+					{
+						t.waiting = true;
+						list_waiting.splice(list_waiting.cend(), list_ready,
+											t.where);
+					}
+					else
+					{
+						list_ready.splice(list_ready.cend(), list_ready,
+										  t.where);
+					}
+				}
+				sched_task& woken = list_tasks[gen() % kTasks];
+				if (woken.waiting)
+				{
+					woken.waiting = false;
+					list_ready.splice(list_ready.cend(), list_waiting,
+									  woken.where);
+				}
+			}
+		});
+
+	for (size_t i = 0; i < kTasks; ++i)
+	{
+		ASSERT_EQ(intrusive_tasks[i].runs, list_tasks[i].runs);
+	}
+	std::cout << "scheduler churn ns/tick: intrusive_list "
+			  << intrusive_ms * 1e6 / kTicks << ", bmstu::list<task*> "
+			  << list_ms * 1e6 / kTicks << "; node pool allocator calls: "
+			  << list_ready.get_pool()->system_allocations() << "\n";
+}
@@ -1,483 +1,1115 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <ostream>
+#include <type_traits>
+#include <utility>
 #include "abstract_iterator.h"
+#include "node_pool.h"
 
 namespace bmstu
 {
-template <typename T>
+// Двусвязный список с одним кольцевым сторожем, встроенным в сам объект:
+// end() указывает на него, begin() — на его next. Узлы берутся из пула
+// (node_pool), поэтому push/clear в цикле не ходят в системный аллокатор.
+// Списки, созданные с общим пулом, могут обмениваться узлами; пул не
+// потокобезопасен, такие списки должны жить в одном потоке. Общим пул
+// становится и неявно: пустой список (или список без пула) при splice или
+// merge переходит на пул источника, и дальше оба списка берут узлы из него.
+// Чтобы разнести списки по потокам, переносите элементы в список со своим
+// пулом через конструктор копирования или insert.
+//
+// Indexed = true (indexed_list<T>) включает индекс порядковых статистик:
+// узлы дополнительно образуют декартово дерево по неявному ключу (позиции)
+// с размерами поддеревьев. Тогда operator[], += на большое n и разность
+// итераторов работают за O(log n) в среднем, а вставка и удаление — тоже
+// за O(log n) вместо O(1). Сторож служит заголовком дерева: его left —
+// корень, а weight == 0 отличает его от узлов.
+template <typename T, bool Indexed = false>
 class list
-{private:
-	struct node
+{
+	struct node_base;
+
+	struct tree_links
+	{
+		node_base* parent = nullptr;
+		node_base* left = nullptr;
+		node_base* right = nullptr;
+		size_t weight = 0;
+	};
+
+	struct no_links
+	{
+	};
+
+	struct node_base : std::conditional_t<Indexed, tree_links, no_links>
 	{
+		node_base* next = nullptr;
+		node_base* prev = nullptr;
+	};
+
+	struct node : node_base
+	{
+		template <typename... Args>
+		explicit node(Args&&... args) : data(std::forward<Args>(args)...)
+		{
+		}
+
 		T data;
-		node* next;
-		node* prev;
-		node() : next(nullptr), prev(nullptr) {}
-		node(node* p, const T& d, node* n) : data(d), prev(p), next(n) {}
 	};
-	node* head_;
-	node* tail_;
-	size_t size_;
 
-public:
-	class iterator	: public abstract_iterator<iterator, T, std::bidirectional_iterator_tag>{
-	private: 
-		node* current_node;
+	template <bool Const>
+	class basic_iterator final
+		: public abstract_iterator<basic_iterator<Const>,
+								   std::conditional_t<Const, const T, T>,
+								   std::bidirectional_iterator_tag>
+	{
+		using base = abstract_iterator<basic_iterator<Const>,
+									   std::conditional_t<Const, const T, T>,
+									   std::bidirectional_iterator_tag>;
+		friend class list;
 
-	public:
-		using difference_type = std::ptrdiff_t;
-		using value_type = T;
-		using pointer = T*;
-		using reference = T&;
-		using iterator_category = std::bidirectional_iterator_tag;
+	   public:
+		using typename base::difference_type;
+		using typename base::pointer;
+		using typename base::reference;
 
-		iterator(node* node) : current_node(node) {}
+		basic_iterator() = default;
 
-		reference operator*() const override {
-			return current_node->data;
-		}
-		pointer operator->() const override{
-			return &(current_node->data);
+		explicit basic_iterator(node_base* node) noexcept : node_(node) {}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(node_);
 		}
 
-		iterator operator++(int) override {
-			iterator temp = *this;
-			current_node = current_node->next;
-			return temp;
+		reference operator*() const override
+		{
+			return static_cast<node*>(node_)->data;
+		}
 
+		pointer operator->() const override
+		{
+			return &static_cast<node*>(node_)->data;
 		}
 
-		iterator& operator++ () override{
-			current_node = current_node->next;
+		basic_iterator& operator++() override
+		{
+			node_ = node_->next;
 			return *this;
 		}
 
-		iterator operator--(int) override {
-			iterator temp = *this;
-			current_node = current_node->prev;
-			return temp;
+		basic_iterator operator++(int) override
+		{
+			basic_iterator tmp = *this;
+			node_ = node_->next;
+			return tmp;
 		}
 
-		iterator& operator--() override {
-			current_node = current_node->prev;
+		basic_iterator& operator--() override
+		{
+			node_ = node_->prev;
 			return *this;
 		}
 
-		iterator& operator+=(const difference_type& n) override {
-			if (n>0) {
-				for (difference_type i = 0; i <n; ++i) {
-					current_node = current_node->next;
-				}
-			} else if (n < 0) {
-				for (difference_type i = 0; i < -n; ++i) {
-					current_node = current_node ->prev;
+		basic_iterator operator--(int) override
+		{
+			basic_iterator tmp = *this;
+			node_ = node_->prev;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(const difference_type& n) override
+		{
+			if constexpr (Indexed)
+			{
+				if (n > kLinearSteps || n < -kLinearSteps)
+				{
+					node_ = list::advance_(node_, n);
+					return *this;
 				}
 			}
+			for (difference_type i = 0; i < n; ++i)
+			{
+				node_ = node_->next;
+			}
+			for (difference_type i = 0; i > n; --i)
+			{
+				node_ = node_->prev;
+			}
 			return *this;
 		}
 
-		iterator& operator-=(const difference_type& n) override{
-			return *this += (-n);
+		basic_iterator& operator-=(const difference_type& n) override
+		{
+			return *this += -n;
 		}
 
-		iterator operator+(const difference_type& n) const override{
-			iterator temp = *this;
-			temp += n;
-			return temp;
+		basic_iterator operator+(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp += n;
 		}
 
-		iterator operator-(const difference_type& n) const override {
-			iterator temp = *this;
-			temp -= n;
-			return temp;
+		basic_iterator operator-(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp -= n;
 		}
 
-		difference_type operator-(const iterator& other) const override {
+		// Число шагов вперёд от other до *this; other не должен стоять после
+		// *this. С индексом — любой порядок и O(log n).
+		difference_type operator-(const basic_iterator& other) const override
+		{
+			if constexpr (Indexed)
+			{
+				return static_cast<difference_type>(list::rank_(node_)) -
+					   static_cast<difference_type>(list::rank_(other.node_));
+			}
 			difference_type count = 0;
-			node* temp = other.current_node;
-			while (temp != current_node && temp != nullptr) {
-				temp = temp->next;
+			for (node_base* it = other.node_; it != node_; it = it->next)
+			{
 				++count;
 			}
-			if (temp ==current_node) {
-				return count;
-			}
-			return -count;
+			return count;
 		}
 
-		bool operator==(const iterator& other) const override {
-			return current_node == other.current_node;
+		bool operator==(const basic_iterator& other) const override
+		{
+			return node_ == other.node_;
 		}
 
-		bool operator!=(const iterator& other) const override {
-			return !(*this == other);
+		bool operator!=(const basic_iterator& other) const override
+		{
+			return node_ != other.node_;
 		}
 
-		explicit operator bool() const override {
-			return current_node != nullptr;
-		}
+		explicit operator bool() const override { return node_ != nullptr; }
+
+	   private:
+		node_base* node_ = nullptr;
 	};
 
-	using const_iterator = iterator;
+   public:
+	using value_type = T;
+	using pool_type = node_pool<node>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
 
-	list() {
-		head_ = new node();
-		tail_ = new node();
-		head_->next = tail_;
-		tail_->prev = head_;
-		size_ = 0;
-	}
+	list() noexcept { reset_links_(); }
 
-	template <typename it>
-	list(it begin, it end)
-	{	head_ = new node();
-		tail_ = new node();
-		head_->next = tail_;
-		tail_->prev = head_;
-		size_ = 0;
-		for (auto iter = begin; iter != end; ++iter) {
-			push_back(*iter);
-		}
+	// Список, берущий узлы из общего пула.
+	explicit list(std::shared_ptr<pool_type> pool) noexcept
+		: pool_(std::move(pool))
+	{
+		reset_links_();
 	}
 
-	list(std::initializer_list<T> values) {
-		head_ = new node();
-		tail_ = new node();
-		head_->next = tail_;
-		tail_->prev = head_;
-		size_ = 0;
-		for (const auto& val: values) {
-			push_back(val);
+	// С move_iterator элементы перемещаются, а не копируются. Если длину
+	// диапазона можно узнать заранее, все узлы строятся подряд в одном
+	// слэбе пула, и обход идёт по памяти последовательно.
+	template <typename It>
+	list(It first, It last) : list()
+	{
+		if constexpr (std::forward_iterator<It>)
+		{
+			append_n_(first, static_cast<size_t>(std::distance(first, last)));
+		}
+		else
+		{
+			for (; first != last; ++first)
+			{
+				emplace_back(*first);
+			}
 		}
 	}
 
-	list(const list& other) {
-		head_ = new node();
-		tail_ = new node();
-		head_->next = tail_;
-		tail_->prev = head_;
-		size_= 0;
-		for (const auto& val : other) {
-			push_back(val);
-		}
+	list(std::initializer_list<T> values) : list(values.begin(), values.end())
+	{
 	}
 
-	list(list&& other) : head_(other.head_), tail_(other.tail_), size_(other.size_) {
-		other.head_ = new node();
-		other.tail_ = new node();
-		other.head_->next = other.tail_;
-		other.tail_->prev = other.head_;
-		other.size_ = 0;
+	list(const list& other) : list()
+	{
+		append_n_(other.begin(), other.size_);
 	}
 
-	~list() {
-		struct node* current = head_;
-		while (current != nullptr) {
-			node* next = current->next;
-			delete current;
-			current = next;
+	list(list&& other) noexcept : list() { swap(other); }
+
+	~list()
+	{
+		// Если пул больше никому не нужен, а элементы не требуют
+		// деструкторов, память уходит вместе с пулом без обхода узлов.
+		if (!std::is_trivially_destructible_v<T> || pool_.use_count() > 1)
+		{
+			clear();
 		}
 	}
 
-	list& operator=(const list& other) {
-		if (this !=&other) {
+	list& operator=(const list& other)
+	{
+		if (this != &other)
+		{
 			clear();
-			for (const auto& val : other) {
-				push_back(val);
+			for (const T& value : other)
+			{
+				push_back(value);
 			}
 		}
 		return *this;
 	}
-	
-	list& operator=(list&& other) noexcept {
-		if (this != other) {
-			node* current = head_;
-			while (current != nullptr) { 
-				node* next = current->next;
-				delete current;
-				current = next;
-		}
-		head_ = other.head_;
-		tail_ = other.tail_;
-		size_ = other.size_;
-		other.head_ = new node();
-		other.tail_ = new node();
-		other.head_->next = other.tail_;
-		other.tail_->prev = other.head_;
-		other.size_ = 0;
+
+	list& operator=(list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			list tmp(std::move(other));
+			swap(tmp);
 		}
 		return *this;
 	}
 
-	void clear() {
-		node* current = head_->next;
-		while (current != tail_)
+	size_t size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	// Пул узлов; создаётся при первой вставке.
+	const std::shared_ptr<pool_type>& get_pool()
+	{
+		if (!pool_)
+		{
+			pool_ = std::make_shared<pool_type>();
+		}
+		return pool_;
+	}
+
+	void clear() noexcept
+	{
+		node_base* current = sentinel_.next;
+		while (current != &sentinel_)
 		{
-			node* next = current->next;
-			delete current;
+			node_base* next = current->next;
+			destroy_node_(static_cast<node*>(current));
 			current = next;
 		}
-		head_->next = tail_;
-		tail_->prev = head_;
+		reset_links_();
 		size_ = 0;
-		
 	}
 
-	size_t size() const {
-		return size_;
-	}
-	bool empty() const noexcept {
-		return size_ == 0;
+	void swap(list& other) noexcept
+	{
+		std::swap(sentinel_, other.sentinel_);
+		std::swap(size_, other.size_);
+		pool_.swap(other.pool_);
+		fix_links_();
+		other.fix_links_();
 	}
 
-	void swap(list& other) noexcept {
-		std::swap(head_, other.head_);
-		std::swap(tail_, other.tail_);
-		std::swap(size_, other.size_);
+	friend void swap(list& l, list& r) noexcept { l.swap(r); }
+
+	iterator begin() noexcept { return iterator(sentinel_.next); }
+
+	iterator end() noexcept { return iterator(&sentinel_); }
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(sentinel_.next);
 	}
 
-	friend void swap(list& l, list& r) {
-		l.swap(r);
+	const_iterator end() const noexcept { return const_iterator(end_node_()); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+	T& front() noexcept { return *begin(); }
+
+	const T& front() const noexcept { return *begin(); }
+
+	T& back() noexcept { return *--end(); }
+
+	const T& back() const noexcept { return *--end(); }
+
+	void push_back(const T& value) { emplace_back(value); }
+
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	void push_front(const T& value) { emplace_front(value); }
+
+	void push_front(T&& value) { emplace_front(std::move(value)); }
+
+	iterator insert(const_iterator pos, const T& value)
+	{
+		return emplace(pos, value);
 	}
 
-	iterator begin() noexcept {
-		return iterator(head_->next);
+	iterator insert(const_iterator pos, T&& value)
+	{
+		return emplace(pos, std::move(value));
 	}
 
-	iterator end() noexcept {
-		return iterator(tail_);
+	// Элемент конструируется прямо в узле из args.
+	template <typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args)
+	{
+		node_base* created = create_node_(std::forward<Args>(args)...);
+		link_before_(pos.node_, created);
+		return iterator(created);
 	}
 
-	const_iterator begin () const noexcept {
-		return const_iterator(head_->next);
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		return *emplace(cend(), std::forward<Args>(args)...);
 	}
 
-	const_iterator end () const noexcept {
-		return const_iterator(tail_);
+	template <typename... Args>
+	T& emplace_front(Args&&... args)
+	{
+		return *emplace(cbegin(), std::forward<Args>(args)...);
 	}
 
-	const_iterator cbegin() const noexcept {
-		return const_iterator(head_->next);
+	void pop_front() noexcept { erase(cbegin()); }
+
+	void pop_back() noexcept { erase(--cend()); }
+
+	// Разрушает элемент в узле и возвращает итератор на следующий.
+	iterator erase(const_iterator pos) noexcept
+	{
+		node_base* next = pos.node_->next;
+		unlink_(pos.node_);
+		destroy_node_(static_cast<node*>(pos.node_));
+		return iterator(next);
 	}
 
-	const_iterator cend() const noexcept {
-		return const_iterator(tail_);
+	iterator erase(const_iterator first, const_iterator last) noexcept
+	{
+		while (first != last)
+		{
+			first = erase(first);
+		}
+		return iterator(last.node_);
 	}
-	void push_back (const T& value) {
-		node* last = tail_->prev;
-		node* new_last = new node(last, value, tail_);
-		last->next = new_last;
-		tail_->prev = new_last;
-		++size_;
+
+	// Переносит все узлы other перед pos. Узлы переходят без копирования,
+	// если у списков общий пул, а пустой список или список без пула ради
+	// этого переходит на пул other — после чего делит его с other (см.
+	// комментарий к классу). Иначе элементы перемещаются в новые узлы из
+	// своего пула.
+	void splice(const_iterator pos, list& other)
+	{
+		transfer_(pos, other, other.begin(), other.end(), other.size_);
 	}
 
-	void push_front(const T& value) {
-		node* first = head_->next;
-		node* new_first = new node(head_, value, first);
-		head_->next = new_first;
-		first->prev = new_first;
-		++size_;
+	void splice(const_iterator pos, list&& other) { splice(pos, other); }
+
+	void splice(const_iterator pos, list& other, const_iterator it)
+	{
+		if (pos == it)
+		{
+			return;
+		}
+		transfer_(pos, other, it, std::next(it), 1);
 	}
 
-	iterator insert(const_iterator pos, const T& value) {
-		node* current = pos.current_node;
-		node* prev = current->prev;
-		node* new_node = new node(prev, value, current);
-		prev->next = new_node;
-		++size_;
-		return iterator (new_node);
+	void splice(const_iterator pos, list&& other, const_iterator it)
+	{
+		splice(pos, other, it);
 	}
 
-	const T& operator[](size_t pos) {
-		node* current = head_->next;
-		for (size_t i = 0; i < pos; ++i) {
-			current = current->next;
-		}
-		return current->data;;
+	// Для другого списка размер диапазона считается обходом.
+	void splice(const_iterator pos,
+				list& other,
+				const_iterator first,
+				const_iterator last)
+	{
+		const size_t count =
+			this == &other ? 0 : static_cast<size_t>(last - first);
+		transfer_(pos, other, first, last, count);
 	}
 
-	T& operator[](size_t pos) {
-		node* current = head_->nextt;
-		for (size_t i = 0; i < pos; ++i) {
-			current = current->next;
-		}
-		return current->data;
+	void splice(const_iterator pos,
+				list&& other,
+				const_iterator first,
+				const_iterator last)
+	{
+		splice(pos, other, first, last);
 	}
 
-	friend bool operator==(const list& l, const list& r) {
-		if (l.size_ != r.size_) return false;
-		auto it1 = l.begin();
-		auto it2 - r.begin();
-		while (it1 !=l.end()) {
-			if (*it1 != *it2) return false;
-			++it1;
-			++it2;
+	// Сливает два упорядоченных списка за O(size() + other.size()).
+	// Слияние устойчиво: при равенстве элементы *this идут раньше. Пул
+	// выбирается как в splice: пустой список переходит на пул other.
+	template <typename Compare = std::less<>>
+	void merge(list& other, Compare comp = {})
+	{
+		if (this == &other || other.empty())
+		{
+			return;
 		}
-		return true;
-	}
-	friend std::ostream& operator<<(std::ostream& os, const list& other) {
-		for (const auto& cal : other) {
-			os << val << "";
+		if (!adopt_pool_(other))
+		{
+			list moved(pool_);
+			moved.splice(moved.end(), other);
+			merge(moved, comp);
+			return;
 		}
-		return os;
+		node_base* merged =
+			merge_chains_(take_chain_(), other.take_chain_(), comp);
+		size_ += other.size_;
+		other.size_ = 0;
+		other.reset_links_();
+		relink_chain_(merged);
 	}
-	friend bool operator!=(const list& l,  const list& r) {
-		return!(l==r);
+
+	template <typename Compare = std::less<>>
+	void merge(list&& other, Compare comp = {})
+	{
+		merge(other, comp);
 	}
 
-	friend auto operator<=>(const list& l, const list& r) {
-		auto it1 = l.begin();
-		auto it2 = r.begin();
-		while (it1 !=l.end() && it2 !=r.end()){
-			if (*it1 < *it2) return std::strong_ordering::less;
-			if (*it2 < *it1) return std::strong_ordering::greater;
-			++it1;
-			++it2;
+	// Устойчивая сортировка слиянием снизу вверх: O(n log n) сравнений,
+	// O(1) дополнительной памяти, элементы не копируются и не
+	// перемещаются — меняются только указатели узлов.
+	template <typename Compare = std::less<>>
+	void sort(Compare comp = {})
+	{
+		if (size_ < 2)
+		{
+			return;
+		}
+		// bins[i] — отсортированная цепочка из 2^i узлов или пусто.
+		node_base* bins[64] = {};
+		size_t used = 0;
+		node_base* current = take_chain_();
+		while (current != nullptr)
+		{
+			node_base* carry = current;
+			current = current->next;
+			carry->next = nullptr;
+			size_t i = 0;
+			for (; i < used && bins[i] != nullptr; ++i)
+			{
+				carry = merge_chains_(bins[i], carry, comp);
+				bins[i] = nullptr;
+			}
+			if (i == used)
+			{
+				++used;
+			}
+			bins[i] = carry;
+		}
+		// Старшие корзины содержат более ранние элементы.
+		node_base* result = nullptr;
+		for (size_t i = 0; i < used; ++i)
+		{
+			if (bins[i] != nullptr)
+			{
+				result = result == nullptr
+							 ? bins[i]
+							 : merge_chains_(bins[i], result, comp);
+			}
 		}
-		if (it1 ==l.end() && it2 !=r.end()) return std::strong_ordering::less;
-		if (it1 !=l.end() && it2 ==r.end()) return std::strong_ordering::greater
-		return std::strong_ordering::equal;
+		relink_chain_(result);
 	}
 
-	friend std::ostream& operator<<(std::ostream& os, const list& other) {
-		for (const auto& val : other) {
-			os << val << " ";
-		}
-		return os;
+	// Обход с программной подкачкой для списков, узлы которых разбросаны
+	// по памяти. Второй указатель идёт на distance узлов впереди f и
+	// подкачивает каждый следующий узел заранее: его промахи не зависят от
+	// работы f, и процессор выполняет их параллельно. hint(value) может
+	// вернуть адрес, на который ссылается элемент (буфер строки, объект по
+	// указателю); он подкачивается за distance шагов до вызова f.
+	template <typename F, typename Hint = std::nullptr_t>
+	void for_each_prefetch(F f, size_t distance = 8, Hint hint = nullptr)
+	{
+		for_each_prefetch_<T>(sentinel_.next, &sentinel_, f, distance, hint);
 	}
-private:
-static bool lexicographical_compare_(const list<T>& l, const list<T>& r) {
-	auto it1 =l.begin();
-	auto it2 =r.begin();
-	while (it1 != l.end() && it2 !=r.end()) {
-		if (*it1 < *it2) return true;
-		if (*it2 < *it1) return false;
-		++it1;
-		++it2;
+
+	template <typename F, typename Hint = std::nullptr_t>
+	void for_each_prefetch(F f,
+						   size_t distance = 8,
+						   Hint hint = nullptr) const
+	{
+		for_each_prefetch_<const T>(sentinel_.next, end_node_(), f, distance,
+									hint);
 	}
-	return (it1 == l.end() && it2 != r.end)
-}
 
-	
-#pragma endregion
-#pragma region pushs
+	T& operator[](size_t pos) noexcept
+	{
+		if constexpr (Indexed)
+		{
+			return static_cast<node*>(select_(&sentinel_, pos))->data;
+		}
+		return *(begin() + pos);
+	}
 
-	template <typename Type>
-	void push_back(const Type& value)
+	const T& operator[](size_t pos) const noexcept
 	{
-		node* last = tail_->prev_node_;
-		node* new_last = new node(tail_->prev_node_, value, tail_);
-		tail_->prev_node_ = new_last;
-		last->next_node_ = new_last;
-		++size_;
+		return const_cast<list&>(*this)[pos];
 	}
 
-	template <typename Type>
-	void push_front(const Type& value)
+	friend bool operator==(const list& l, const list& r)
 	{
-		// адрес реального последнего элемента
-		node* first = head_->next_node_;
-		node* new_first = new node(head_, value, first);
-		head_->next_node_ = new_first;
-		first->prev_node_ = new_first;
-		++size_;
+		return l.size_ == r.size_ && std::equal(l.begin(), l.end(), r.begin());
 	}
 
-#pragma endregion
+	friend bool operator!=(const list& l, const list& r) { return !(l == r); }
+
+	friend auto operator<=>(const list& l, const list& r)
+	{
+		if (lexicographical_compare_(l, r))
+		{
+			return std::weak_ordering::less;
+		}
+		if (lexicographical_compare_(r, l))
+		{
+			return std::weak_ordering::greater;
+		}
+		return std::weak_ordering::equivalent;
+	}
 
-	bool empty() const
+	friend std::ostream& operator<<(std::ostream& os, const list& other)
+	{
+		os << "{";
+		for (auto it = other.begin(); it != other.end(); ++it)
+		{
+			if (it != other.begin())
+			{
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os << "}";
+	}
 
-		noexcept
+   private:
+	static bool lexicographical_compare_(const list& l, const list& r)
 	{
-		return (size_ == 0u);
+		return std::lexicographical_compare(l.begin(), l.end(), r.begin(),
+											r.end());
 	}
 
-	~list() {}
+	node_base* end_node_() const noexcept
+	{
+		return const_cast<node_base*>(&sentinel_);
+	}
 
-	void clear() {}
+	static void prefetch_(const void* p) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(p, 0, 3);
+#else
+		(void)p;
+#endif
+	}
 
-	size_t size() const { return 0; }
+	template <typename Value, typename F, typename Hint>
+	static void for_each_prefetch_(node_base* current,
+								   node_base* end,
+								   F& f,
+								   size_t distance,
+								   Hint& hint)
+	{
+		// ahead держится на distance узлов впереди current; его узел
+		// подкачан на прошлом шаге, так что hint и next читаются из кэша.
+		node_base* ahead = current;
+		for (size_t i = 0; i < distance && ahead != end; ++i)
+		{
+			ahead = ahead->next;
+			prefetch_(ahead);
+		}
+		for (; current != end; current = current->next)
+		{
+			if (ahead != end)
+			{
+				if constexpr (!std::is_null_pointer_v<Hint>)
+				{
+					prefetch_(hint(static_cast<const node*>(ahead)->data));
+				}
+				ahead = ahead->next;
+				prefetch_(ahead);
+			}
+			f(static_cast<Value&>(static_cast<node*>(current)->data));
+		}
+	}
 
-	void swap(list& other)
+	void reset_links_() noexcept
+	{
+		sentinel_.next = &sentinel_;
+		sentinel_.prev = &sentinel_;
+		if constexpr (Indexed)
+		{
+			sentinel_.left = nullptr;
+		}
+	}
 
-		noexcept
+	// После копирования сторожа побайтно соседи должны смотреть на новый адрес.
+	void fix_links_() noexcept
 	{
+		if (size_ == 0)
+		{
+			reset_links_();
+			return;
+		}
+		sentinel_.next->prev = &sentinel_;
+		sentinel_.prev->next = &sentinel_;
+		if constexpr (Indexed)
+		{
+			sentinel_.left->parent = &sentinel_;
+		}
 	}
 
-	friend void swap(list& l, list& r) { l.swap(r); }
+	template <typename... Args>
+	node* create_node_(Args&&... args)
+	{
+		pool_type& pool = *get_pool();
+		node* memory = pool.allocate();
+		try
+		{
+			return ::new (static_cast<void*>(memory))
+				node(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			pool.deallocate(memory);
+			throw;
+		}
+	}
 
-#pragma region iterators
+	void destroy_node_(node* n) noexcept
+	{
+		n->~node();
+		pool_->deallocate(n);
+	}
 
-	iterator begin()
+	// Узлы other можно забрать без копирования, если пул у списков общий.
+	// Список без пула, как и пустой список с неразделяемым пулом,
+	// переходит на пул other.
+	bool adopt_pool_(const list& other) noexcept
+	{
+		if (pool_ == other.pool_)
+		{
+			return true;
+		}
+		if (!pool_ || (empty() && pool_.use_count() == 1))
+		{
+			pool_ = other.pool_;
+			return true;
+		}
+		return false;
+	}
 
-		noexcept
+	void transfer_(const_iterator pos,
+				   list& other,
+				   const_iterator first,
+				   const_iterator last,
+				   size_t count)
 	{
-		return iterator{head_->next_node_};
+		if (first == last)
+		{
+			return;
+		}
+		if (!adopt_pool_(other))
+		{
+			while (first != last)
+			{
+				node* source = static_cast<node*>((first++).node_);
+				link_before_(pos.node_, create_node_(std::move(source->data)));
+				other.unlink_(source);
+				other.destroy_node_(source);
+			}
+			return;
+		}
+		if constexpr (Indexed)
+		{
+			if (count == 1)
+			{
+				node_base* single = first.node_;
+				other.unlink_(single);
+				link_before_(pos.node_, single);
+				return;
+			}
+		}
+		node_base* head = first.node_;
+		node_base* tail = last.node_->prev;
+		head->prev->next = last.node_;
+		last.node_->prev = head->prev;
+
+		head->prev = pos.node_->prev;
+		tail->next = pos.node_;
+		pos.node_->prev->next = head;
+		pos.node_->prev = tail;
+		other.size_ -= count;
+		size_ += count;
+		if constexpr (Indexed)
+		{
+			rebuild_index_();
+			if (this != &other)
+			{
+				other.rebuild_index_();
+			}
+		}
 	}
 
-	iterator end()
+	// Размыкает кольцо: узлы образуют цепочку по next, оканчивающуюся
+	// nullptr. prev и сторож остаются старыми до relink_chain_.
+	node_base* take_chain_() noexcept
+	{
+		if (size_ == 0)
+		{
+			return nullptr;
+		}
+		sentinel_.prev->next = nullptr;
+		return sentinel_.next;
+	}
 
-		noexcept
+	// Восстанавливает prev и замыкает цепочку на сторожа.
+	void relink_chain_(node_base* head) noexcept
 	{
-		return iterator{tail_};
+		node_base* prev = &sentinel_;
+		for (node_base* n = head; n != nullptr; n = n->next)
+		{
+			n->prev = prev;
+			prev = n;
+		}
+		prev->next = &sentinel_;
+		sentinel_.prev = prev;
+		sentinel_.next = head != nullptr ? head : &sentinel_;
+		if constexpr (Indexed)
+		{
+			rebuild_index_();
+		}
 	}
 
-	const_iterator begin() const
+	// Сливает цепочки по next; при равенстве первым идёт узел из first.
+	template <typename Compare>
+	static node_base* merge_chains_(node_base* first,
+									node_base* second,
+									Compare& comp)
+	{
+		node_base head;
+		node_base* tail = &head;
+		while (first != nullptr && second != nullptr)
+		{
+			if (comp(static_cast<node*>(second)->data,
+					 static_cast<node*>(first)->data))
+			{
+				tail->next = second;
+				second = second->next;
+			}
+			else
+			{
+				tail->next = first;
+				first = first->next;
+			}
+			tail = tail->next;
+		}
+		tail->next = first != nullptr ? first : second;
+		return head.next;
+	}
 
-		noexcept
+	void unlink_(node_base* n) noexcept
 	{
-		return const_iterator{head_->next_node_};
+		if constexpr (Indexed)
+		{
+			tree_erase_(n);
+		}
+		n->prev->next = n->next;
+		n->next->prev = n->prev;
+		--size_;
 	}
 
-	const_iterator end() const
+	// Достраивает хвост из count элементов, начиная с first, в одном
+	// слэбе. Если конструктор элемента бросит, список остаётся прежним, а
+	// все узлы слэба уходят в список свободных.
+	template <typename It>
+	void append_n_(It first, size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		pool_type& pool = *get_pool();
+		node* block = pool.allocate_bulk(count);
+		node_base* tail = sentinel_.prev;
+		size_t built = 0;
+		try
+		{
+			for (; built < count; ++built, ++first)
+			{
+				node* n =
+					::new (static_cast<void*>(block + built)) node(*first);
+				n->prev = tail;
+				tail->next = n;
+				tail = n;
+			}
+		}
+		catch (...)
+		{
+			std::destroy_n(block, built);
+			for (size_t i = 0; i < count; ++i)
+			{
+				pool.deallocate(block + i);
+			}
+			sentinel_.prev->next = &sentinel_;
+			throw;
+		}
+		tail->next = &sentinel_;
+		sentinel_.prev = tail;
+		size_ += count;
+		if constexpr (Indexed)
+		{
+			rebuild_index_();
+		}
+	}
 
-		noexcept
+	void link_before_(node_base* pos, node_base* n) noexcept
 	{
-		return const_iterator{tail_};
+		n->next = pos;
+		n->prev = pos->prev;
+		pos->prev->next = n;
+		pos->prev = n;
+		++size_;
+		if constexpr (Indexed)
+		{
+			tree_insert_(n);
+		}
 	}
 
-	const_iterator cbegin() const
+	// Дальше — индекс порядковых статистик для Indexed = true.
 
-		noexcept
+	// Сдвиги не дальше этого проходят по списку, а не через дерево.
+	static constexpr std::ptrdiff_t kLinearSteps = 8;
+
+	static size_t weight_(const node_base* x) noexcept
 	{
-		return const_iterator{head_->next_node_};
+		return x != nullptr ? x->weight : 0;
 	}
 
-	const_iterator cend() const
+	static void update_(node_base* x) noexcept
+	{
+		x->weight = 1 + weight_(x->left) + weight_(x->right);
+	}
 
-		noexcept
+	// Приоритет кучи — хеш адреса узла (splitmix64): отдельное поле и
+	// генератор не нужны, а адреса из пула перемешиваются достаточно.
+	static uint64_t priority_(const node_base* x) noexcept
 	{
-		return const_iterator{tail_};
+		uint64_t z = reinterpret_cast<uintptr_t>(x) + 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
 	}
 
-#pragma endregion
+	static bool is_header_(const node_base* x) noexcept
+	{
+		return x->weight == 0;
+	}
 
-	T operator[](size_t pos) const {}
+	// Позиция узла в списке; для сторожа — размер списка.
+	static size_t rank_(const node_base* x) noexcept
+	{
+		if (is_header_(x))
+		{
+			return weight_(x->left);
+		}
+		size_t rank = weight_(x->left);
+		for (; !is_header_(x->parent); x = x->parent)
+		{
+			if (x == x->parent->right)
+			{
+				rank += weight_(x->parent->left) + 1;
+			}
+		}
+		return rank;
+	}
 
+	// Узел на позиции k; k == размеру — сам сторож.
+	static node_base* select_(node_base* header, size_t k) noexcept
+	{
+		if (k == weight_(header->left))
+		{
+			return header;
+		}
+		node_base* x = header->left;
+		while (true)
+		{
+			const size_t left = weight_(x->left);
+			if (k < left)
+			{
+				x = x->left;
+			}
+			else if (k == left)
+			{
+				return x;
+			}
+			else
+			{
+				k -= left + 1;
+				x = x->right;
+			}
+		}
+	}
 
-	friend bool operator==(const list& l, const list& r) { return true; }
+	static node_base* advance_(node_base* x, std::ptrdiff_t n) noexcept
+	{
+		const size_t target = rank_(x) + n;
+		while (!is_header_(x))
+		{
+			x = x->parent;
+		}
+		return select_(x, target);
+	}
 
-	friend bool operator!=(const list& l, const list& r) { return false; }
+	void replace_child_(node_base* parent,
+						node_base* from,
+						node_base* to) noexcept
+	{
+		if (parent == &sentinel_ || parent->left == from)
+		{
+			parent->left = to;
+		}
+		else
+		{
+			parent->right = to;
+		}
+	}
 
-	friend auto operator<=>(const list& lhs, const list& rhs) { return true; }
+	// Поворот, поднимающий x над его родителем.
+	void rotate_up_(node_base* x) noexcept
+	{
+		node_base* p = x->parent;
+		node_base* g = p->parent;
+		if (x == p->left)
+		{
+			p->left = x->right;
+			if (x->right != nullptr)
+			{
+				x->right->parent = p;
+			}
+			x->right = p;
+		}
+		else
+		{
+			p->right = x->left;
+			if (x->left != nullptr)
+			{
+				x->left->parent = p;
+			}
+			x->left = p;
+		}
+		p->parent = x;
+		x->parent = g;
+		replace_child_(g, p, x);
+		update_(p);
+		update_(x);
+	}
 
-	friend std::ostream& operator<<(std::ostream& os, const list& other)
+	// Узел уже стоит в списке; в дереве он встаёт тем же порядком: левым
+	// сыном следующего узла или правым сыном предыдущего.
+	void tree_insert_(node_base* n) noexcept
 	{
-		return os;
+		n->left = nullptr;
+		n->right = nullptr;
+		n->weight = 1;
+		node_base* next = n->next;
+		if (sentinel_.left == nullptr)
+		{
+			sentinel_.left = n;
+			n->parent = &sentinel_;
+			return;
+		}
+		if (next != &sentinel_ && next->left == nullptr)
+		{
+			next->left = n;
+			n->parent = next;
+		}
+		else
+		{
+			n->prev->right = n;
+			n->parent = n->prev;
+		}
+		for (node_base* p = n->parent; p != &sentinel_; p = p->parent)
+		{
+			++p->weight;
+		}
+		while (n->parent != &sentinel_ && priority_(n->parent) < priority_(n))
+		{
+			rotate_up_(n);
+		}
 	}
 
-	iterator insert(const_iterator pos, const T& value)
+	void tree_erase_(node_base* n) noexcept
 	{
-		return iterator{nullptr};
+		while (n->left != nullptr || n->right != nullptr)
+		{
+			node_base* child = n->left;
+			if (child == nullptr ||
+				(n->right != nullptr && priority_(n->right) > priority_(child)))
+			{
+				child = n->right;
+			}
+			rotate_up_(child);
+		}
+		node_base* parent = n->parent;
+		replace_child_(parent, n, nullptr);
+		for (; parent != &sentinel_; parent = parent->parent)
+		{
+			--parent->weight;
+		}
 	}
 
-   private:
-	static bool lexicographical_compare_(const list<T>& l, const list<T>& r)
+	// Строит дерево заново за O(n) по порядку списка: правая граница дерева
+	// служит стеком, узел, снятый с неё, уже окончателен.
+	void rebuild_index_() noexcept
 	{
-		return "123";
+		sentinel_.left = nullptr;
+		node_base* spine = &sentinel_;
+		for (node_base* n = sentinel_.next; n != &sentinel_; n = n->next)
+		{
+			const uint64_t priority = priority_(n);
+			node_base* lower = nullptr;
+			while (spine != &sentinel_ && priority_(spine) < priority)
+			{
+				update_(spine);
+				lower = spine;
+				spine = spine->parent;
+			}
+			n->left = lower;
+			n->right = nullptr;
+			if (lower != nullptr)
+			{
+				lower->parent = n;
+			}
+			if (spine == &sentinel_)
+			{
+				sentinel_.left = n;
+			}
+			else
+			{
+				spine->right = n;
+			}
+			n->parent = spine;
+			spine = n;
+		}
+		for (; spine != &sentinel_; spine = spine->parent)
+		{
+			update_(spine);
+		}
 	}
 
+	std::shared_ptr<pool_type> pool_;
+	node_base sentinel_;
 	size_t size_ = 0;
 };
-}  // namespace bmstu
\ No newline at end of file
+
+// Список с индексом порядковых статистик, см. описание list.
+template <typename T>
+using indexed_list = list<T, true>;
+}  // namespace bmstu
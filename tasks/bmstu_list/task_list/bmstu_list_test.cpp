@@ -2,6 +2,15 @@
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench.h"
 
 TEST(BidirectLinkedListTests, init)
 {
@@ -535,4 +544,902 @@ TEST(BidirectLinkedListTests, from_vector)
 										"string4"s, "string5"s, "string6"s,
 										"string7"s, "end_string"s}),
 			  my_vec);
-}
\ No newline at end of file
+}
+TEST(BidirectLinkedListTests, pool_recycles_nodes)
+{
+	bmstu::list<int> list;
+	for (int i = 0; i < 1000; ++i)
+	{
+		list.push_back(i);
+	}
+	const auto& pool = *list.get_pool();
+	const size_t allocations = pool.system_allocations();
+	const size_t capacity = pool.capacity();
+	ASSERT_GE(capacity, 1000u);
+	ASSERT_LT(allocations, 16u);
+	for (int round = 0; round < 10; ++round)
+	{
+		list.clear();
+		for (int i = 0; i < 1000; ++i)
+		{
+			list.push_front(i);
+		}
+	}
+	ASSERT_EQ(pool.system_allocations(), allocations);
+	ASSERT_EQ(pool.capacity(), capacity);
+	ASSERT_EQ(list.front(), 999);
+	ASSERT_EQ(list.back(), 0);
+}
+
+TEST(BidirectLinkedListTests, shared_pool)
+{
+	auto pool = std::make_shared<bmstu::list<std::string>::pool_type>();
+	{
+		bmstu::list<std::string> first(pool);
+		bmstu::list<std::string> second(pool);
+		first.push_back("a");
+		second.push_back("b");
+		ASSERT_EQ(first.get_pool(), second.get_pool());
+		ASSERT_EQ(pool->slab_count(), 1u);
+	}
+	ASSERT_EQ(pool.use_count(), 1);
+}
+
+TEST(BidirectLinkedListTests, move_and_copy)
+{
+	bmstu::list<std::string> source{"x", "y", "z"};
+	bmstu::list<std::string> copy(source);
+	bmstu::list<std::string> moved(std::move(source));
+	ASSERT_TRUE(source.empty());
+	ASSERT_EQ(source.begin(), source.end());
+	ASSERT_EQ(moved, copy);
+	ASSERT_EQ(*--moved.end(), "z");
+	source.push_back("again");
+	ASSERT_EQ(source.size(), 1u);
+
+	copy = moved;
+	moved = bmstu::list<std::string>{"only"};
+	ASSERT_EQ(moved.size(), 1u);
+	ASSERT_EQ(copy.size(), 3u);
+	ASSERT_TRUE(copy > moved);
+	std::stringstream out;
+	out << bmstu::list<int>{};
+	ASSERT_EQ(out.str(), "{}");
+}
+
+TEST(BidirectLinkedListTests, insert_in_middle)
+{
+	bmstu::list<int> list{1, 3};
+	auto it = list.insert(++list.cbegin(), 2);
+	ASSERT_EQ(*it, 2);
+	list.insert(list.cend(), 4);
+	list.insert(list.cbegin(), 0);
+	ASSERT_EQ(list, (bmstu::list<int>{0, 1, 2, 3, 4}));
+	ASSERT_EQ(*--list.end(), 4);
+}
+
+TEST(BidirectLinkedListTests, splice)
+{
+	bmstu::list<int> source{2, 3, 4};
+	const int* address = &source.front();
+	// Список без пула забирает узлы вместе с пулом источника.
+	bmstu::list<int> target;
+	target.splice(target.cend(), source);
+	ASSERT_TRUE(source.empty());
+	ASSERT_EQ(target.get_pool(), source.get_pool());
+	ASSERT_EQ(&target.front(), address);
+	target.push_front(1);
+	target.push_back(5);
+	ASSERT_EQ(target, (bmstu::list<int>{1, 2, 3, 4, 5}));
+
+	source.splice(source.cend(), target, target.cbegin());
+	ASSERT_EQ(source, (bmstu::list<int>{1}));
+	ASSERT_EQ(target.size(), 4u);
+
+	source.splice(source.cbegin(), target, ++target.cbegin(), --target.cend());
+	ASSERT_EQ(source, (bmstu::list<int>{3, 4, 1}));
+	ASSERT_EQ(target, (bmstu::list<int>{2, 5}));
+
+	// Перестановка внутри одного списка.
+	source.splice(source.cbegin(), source, --source.cend(), source.cend());
+	ASSERT_EQ(source, (bmstu::list<int>{1, 3, 4}));
+	ASSERT_EQ(source.size(), 3u);
+	ASSERT_EQ(*--source.end(), 4);
+
+	target.splice(target.cend(), bmstu::list<int>{6, 7});
+	ASSERT_EQ(target, (bmstu::list<int>{2, 5, 6, 7}));
+}
+
+TEST(BidirectLinkedListTests, splice_between_pools)
+{
+	bmstu::list<std::string> target{"a", "d"};
+	bmstu::list<std::string> source{"b", "c"};
+	const std::string* address = &source.front();
+	target.splice(--target.cend(), source);
+	ASSERT_EQ(target, (bmstu::list<std::string>{"a", "b", "c", "d"}));
+	ASSERT_TRUE(source.empty());
+	ASSERT_NE(target.get_pool(), source.get_pool());
+	ASSERT_NE(&target[1], address);
+
+	// Пустой список без чужих владельцев пула берёт пул источника.
+	source.splice(source.cend(), target, target.cbegin());
+	ASSERT_EQ(source.get_pool(), target.get_pool());
+	ASSERT_EQ(source.front(), "a");
+}
+
+TEST(BidirectLinkedListTests, merge)
+{
+	bmstu::list<std::pair<int, char>> first{{1, 'a'}, {3, 'a'}, {5, 'a'}};
+	bmstu::list<std::pair<int, char>> second{{1, 'b'}, {2, 'b'}, {5, 'b'},
+											 {6, 'b'}};
+	const auto by_key = [](const auto& l, const auto& r)
+	{ return l.first < r.first; };
+	first.merge(second, by_key);
+	ASSERT_TRUE(second.empty());
+	ASSERT_EQ(first, (bmstu::list<std::pair<int, char>>{{1, 'a'},
+														 {1, 'b'},
+														 {2, 'b'},
+														 {3, 'a'},
+														 {5, 'a'},
+														 {5, 'b'},
+														 {6, 'b'}}));
+	ASSERT_EQ(first.size(), 7u);
+	ASSERT_EQ(first.back().first, 6);
+
+	bmstu::list<int> empty;
+	empty.merge(bmstu::list<int>{1, 2});
+	ASSERT_EQ(empty, (bmstu::list<int>{1, 2}));
+	empty.merge(empty);
+	ASSERT_EQ(empty.size(), 2u);
+
+	auto pool = std::make_shared<bmstu::list<int>::pool_type>();
+	bmstu::list<int> shared(pool);
+	shared.push_back(0);
+	shared.push_back(3);
+	empty.merge(shared);
+	ASSERT_EQ(empty, (bmstu::list<int>{0, 1, 2, 3}));
+}
+
+TEST(BidirectLinkedListTests, sort)
+{
+	bmstu::list<int> empty;
+	empty.sort();
+	ASSERT_TRUE(empty.empty());
+
+	std::mt19937 gen(1);
+	for (size_t size : {1, 2, 3, 7, 64, 65, 1000})
+	{
+		bmstu::list<std::pair<int, size_t>> list;
+		std::vector<std::pair<int, size_t>> expected;
+		for (size_t i = 0; i < size; ++i)
+		{
+			list.push_back({static_cast<int>(gen() % 10), i});
+			expected.push_back(list.back());
+		}
+		const auto by_key = [](const auto& l, const auto& r)
+		{ return l.first < r.first; };
+		std::stable_sort(expected.begin(), expected.end(), by_key);
+		const auto* first_address = &list.front();
+		list.sort(by_key);
+		ASSERT_TRUE(std::equal(list.begin(), list.end(), expected.begin(),
+							   expected.end()));
+		ASSERT_EQ(list.size(), size);
+		// Узлы не переезжают: элемент остаётся по тому же адресу.
+		ASSERT_EQ(std::count_if(list.begin(), list.end(),
+								[&](const auto& value)
+								{ return &value == first_address; }),
+				  1);
+		auto back = list.end();
+		for (auto it = expected.rbegin(); it != expected.rend(); ++it)
+		{
+			ASSERT_EQ(*--back, *it);
+		}
+	}
+
+	bmstu::list<int> descending{1, 5, 2, 4, 3};
+	descending.sort(std::greater<>());
+	ASSERT_EQ(descending, (bmstu::list<int>{5, 4, 3, 2, 1}));
+}
+
+TEST(BidirectLinkedListTests, indexed_positional_access)
+{
+	std::mt19937 gen(5);
+	bmstu::indexed_list<int> list;
+	std::vector<int> expected;
+	for (int i = 0; i < 3000; ++i)
+	{
+		const size_t pos = gen() % (expected.size() + 1);
+		switch (gen() % 3)
+		{
+			case 0:
+				list.push_back(i);
+				expected.push_back(i);
+				break;
+			case 1:
+				list.push_front(i);
+				expected.insert(expected.begin(), i);
+				break;
+			default:
+				list.insert(list.cbegin() + pos, i);
+				expected.insert(expected.begin() + pos, i);
+		}
+	}
+	ASSERT_EQ(list.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		ASSERT_EQ(list[i], expected[i]);
+	}
+	for (int probe = 0; probe < 500; ++probe)
+	{
+		const auto a = static_cast<std::ptrdiff_t>(gen() % expected.size());
+		const auto b = static_cast<std::ptrdiff_t>(gen() % expected.size());
+		auto it = list.begin() + a;
+		ASSERT_EQ(*it, expected[a]);
+		ASSERT_EQ((list.begin() + b) - it, b - a);
+		it += b - a;
+		ASSERT_EQ(*it, expected[b]);
+		const auto size = static_cast<std::ptrdiff_t>(expected.size());
+		ASSERT_EQ(list.end() - it, size - b);
+		ASSERT_EQ(it - list.end(), b - size);
+	}
+	ASSERT_EQ(list.begin() + static_cast<std::ptrdiff_t>(list.size()),
+			  list.end());
+	ASSERT_EQ(*(list.end() - 100), expected[expected.size() - 100]);
+	ASSERT_EQ(std::distance(list.begin(), list.end()),
+			  static_cast<std::ptrdiff_t>(expected.size()));
+}
+
+TEST(BidirectLinkedListTests, indexed_relinking)
+{
+	bmstu::indexed_list<int> list;
+	for (int i = 0; i < 200; ++i)
+	{
+		list.push_back((i * 37) % 200);
+	}
+	list.sort();
+	for (int i = 0; i < 200; ++i)
+	{
+		ASSERT_EQ(list[i], i);
+	}
+
+	bmstu::indexed_list<int> other;
+	other.splice(other.cend(), list, list.cbegin() + 50, list.cbegin() + 150);
+	ASSERT_EQ(other.size(), 100u);
+	ASSERT_EQ(list.size(), 100u);
+	ASSERT_EQ(other[0], 50);
+	ASSERT_EQ(other[99], 149);
+	ASSERT_EQ(list[50], 150);
+	ASSERT_EQ(list.end() - list.begin(), 100);
+
+	other.splice(other.cbegin(), list, list.cbegin() + 10);
+	ASSERT_EQ(other[0], 10);
+	ASSERT_EQ(other[1], 50);
+	ASSERT_EQ(list[10], 11);
+	other.splice(other.cbegin(), other, other.cbegin());
+	ASSERT_EQ(other[0], 10);
+
+	list.merge(other);
+	ASSERT_TRUE(other.empty());
+	ASSERT_EQ(list.size(), 200u);
+	for (int i = 0; i < 200; ++i)
+	{
+		ASSERT_EQ(list[i], i);
+	}
+
+	bmstu::indexed_list<int> moved(std::move(list));
+	ASSERT_EQ(moved[199], 199);
+	ASSERT_EQ(moved.end() - moved.begin(), 200);
+	bmstu::indexed_list<int> copy(moved);
+	swap(copy, list);
+	ASSERT_EQ(list[123], 123);
+	ASSERT_EQ(list.end() - (list.begin() + 23), 177);
+	list.clear();
+	list.push_back(7);
+	ASSERT_EQ(list[0], 7);
+	ASSERT_EQ(list.end() - list.begin(), 1);
+}
+
+TEST(BidirectLinkedListTests, move_only_payload)
+{
+	bmstu::list<std::unique_ptr<int>> list;
+	auto value = std::make_unique<int>(2);
+	list.push_back(std::move(value));
+	ASSERT_EQ(value, nullptr);
+	list.push_front(std::make_unique<int>(1));
+	list.emplace_back(new int(4));
+	auto it = list.emplace(--list.cend(), std::make_unique<int>(3));
+	ASSERT_EQ(**it, 3);
+	list.insert(list.cend(), std::make_unique<int>(5));
+	ASSERT_EQ(list.size(), 5u);
+	int expected = 1;
+	for (const auto& item : list)
+	{
+		ASSERT_EQ(*item, expected++);
+	}
+
+	std::vector<std::unique_ptr<int>> source;
+	source.push_back(std::make_unique<int>(7));
+	bmstu::list<std::unique_ptr<int>> moved(
+		std::make_move_iterator(source.begin()),
+		std::make_move_iterator(source.end()));
+	ASSERT_EQ(*moved.front(), 7);
+	ASSERT_EQ(source[0], nullptr);
+}
+
+namespace
+{
+struct counted
+{
+	counted(int a, int b) : sum(a + b) {}
+	counted(const counted& other) : sum(other.sum) { ++copies; }
+	counted(counted&& other) noexcept : sum(other.sum) { ++moves; }
+
+	int sum;
+	static inline int copies = 0;
+	static inline int moves = 0;
+};
+}  // namespace
+
+TEST(BidirectLinkedListTests, emplace_constructs_in_place)
+{
+	bmstu::list<counted> list;
+	list.emplace_back(1, 2);
+	counted& front = list.emplace_front(0, 0);
+	ASSERT_EQ(&front, &list.front());
+	list.emplace(++list.cbegin(), 5, 5);
+	ASSERT_EQ(counted::copies, 0);
+	ASSERT_EQ(counted::moves, 0);
+	list.push_back(counted(2, 2));
+	ASSERT_EQ(counted::copies, 0);
+	ASSERT_EQ(counted::moves, 1);
+	const counted lvalue(3, 3);
+	list.push_back(lvalue);
+	ASSERT_EQ(counted::copies, 1);
+	ASSERT_EQ(list[1].sum, 10);
+	ASSERT_EQ(list.back().sum, 6);
+}
+
+TEST(BidirectLinkedListTests, pop_and_erase)
+{
+	int alive = 0;
+	struct tracked
+	{
+		explicit tracked(int* counter, int id) : counter(counter), id(id)
+		{
+			++*counter;
+		}
+		tracked(const tracked& other) : counter(other.counter), id(other.id)
+		{
+			++*counter;
+		}
+		~tracked() { --*counter; }
+
+		int* counter;
+		int id;
+	};
+
+	bmstu::list<tracked> list;
+	for (int i = 0; i < 8; ++i)
+	{
+		list.emplace_back(&alive, i);
+	}
+	ASSERT_EQ(alive, 8);
+	list.pop_front();
+	list.pop_back();
+	ASSERT_EQ(alive, 6);
+	ASSERT_EQ(list.front().id, 1);
+	ASSERT_EQ(list.back().id, 6);
+
+	auto it = list.erase(++list.cbegin());
+	ASSERT_EQ(it->id, 3);
+	it = list.erase(it, list.cbegin() + 3);
+	ASSERT_EQ(it->id, 5);
+	ASSERT_EQ(alive, 3);
+	ASSERT_EQ(list.size(), 3u);
+	ASSERT_EQ((--list.end())->id, 6);
+	it = list.erase(list.cbegin(), list.cend());
+	ASSERT_EQ(it, list.end());
+	ASSERT_TRUE(list.empty());
+	ASSERT_EQ(alive, 0);
+}
+
+TEST(BidirectLinkedListTests, indexed_erase)
+{
+	bmstu::indexed_list<int> list;
+	std::vector<int> expected;
+	std::mt19937 gen(17);
+	for (int i = 0; i < 2000; ++i)
+	{
+		list.push_back(i);
+		expected.push_back(i);
+	}
+	while (expected.size() > 100)
+	{
+		const size_t pos = gen() % expected.size();
+		list.erase(list.cbegin() + pos);
+		expected.erase(expected.begin() + pos);
+	}
+	list.pop_front();
+	list.pop_back();
+	expected.erase(expected.begin());
+	expected.pop_back();
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		ASSERT_EQ(list[i], expected[i]);
+	}
+	ASSERT_EQ(list.end() - list.begin(), 98);
+}
+
+TEST(BidirectLinkedListTests, bulk_build_is_contiguous)
+{
+	static_assert(std::forward_iterator<bmstu::list<int>::const_iterator>);
+	std::vector<int64_t> values(1000);
+	std::iota(values.begin(), values.end(), 0);
+	bmstu::list<int64_t> list(values.begin(), values.end());
+	ASSERT_EQ(list.size(), values.size());
+	ASSERT_EQ(list.get_pool()->slab_count(), 1u);
+	ASSERT_EQ(list.get_pool()->capacity(), values.size());
+	// Узлы идут в памяти подряд с постоянным шагом.
+	const auto address = [](const int64_t& value)
+	{ return reinterpret_cast<std::uintptr_t>(&value); };
+	const std::uintptr_t first = address(list.front());
+	const std::uintptr_t stride = address(*++list.cbegin()) - first;
+	size_t i = 0;
+	for (const int64_t& value : list)
+	{
+		ASSERT_EQ(value, values[i]);
+		ASSERT_EQ(address(value), first + i * stride);
+		++i;
+	}
+	ASSERT_EQ(*--list.end(), 999);
+
+	bmstu::list<int64_t> copy(list);
+	ASSERT_EQ(copy, list);
+	ASSERT_EQ(copy.get_pool()->slab_count(), 1u);
+
+	// Освобождённые узлы слэба переиспользуются.
+	copy.clear();
+	copy.push_back(1);
+	ASSERT_EQ(copy.get_pool()->slab_count(), 1u);
+
+	bmstu::indexed_list<int64_t> indexed(values.begin(), values.end());
+	ASSERT_EQ(indexed[500], 500);
+	ASSERT_EQ(indexed.end() - (indexed.begin() + 10), 990);
+}
+
+TEST(BidirectLinkedListTests, bulk_build_throw)
+{
+	int alive = 0;
+	struct throwing
+	{
+		throwing(int* counter, int id) : counter(counter), id(id)
+		{
+			++*counter;
+		}
+		throwing(const throwing& other) : counter(other.counter), id(other.id)
+		{
+			if (id == 7)
+			{
+				throw std::runtime_error("copy");
+			}
+			++*counter;
+		}
+		~throwing() { --*counter; }
+
+		int* counter;
+		int id;
+	};
+
+	{
+		std::vector<throwing> values;
+		values.reserve(10);
+		for (int i = 0; i < 10; ++i)
+		{
+			values.emplace_back(&alive, i);
+		}
+		ASSERT_THROW(bmstu::list<throwing>(values.begin(), values.end()),
+					 std::runtime_error);
+		ASSERT_EQ(alive, 10);
+	}
+	ASSERT_EQ(alive, 0);
+}
+
+TEST(BidirectLinkedListTests, for_each_prefetch)
+{
+	bmstu::list<int> list{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	for (size_t distance : {0u, 1u, 3u, 10u, 50u})
+	{
+		std::vector<int> seen;
+		list.for_each_prefetch([&seen](int& value) { seen.push_back(value); },
+							   distance);
+		ASSERT_EQ(seen, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+	}
+	list.for_each_prefetch([](int& value) { value *= 2; });
+	ASSERT_EQ(list, (bmstu::list<int>{2, 4, 6, 8, 10, 12, 14, 16, 18, 20}));
+
+	const std::vector<std::string> strings{"first", "second", "third"};
+	const bmstu::list<const std::string*> pointers{&strings[0], &strings[1],
+												   &strings[2]};
+	std::string joined;
+	pointers.for_each_prefetch(
+		[&joined](const std::string* const& s) { joined += *s; }, 2,
+		[](const std::string* const& s) { return s->data(); });
+	ASSERT_EQ(joined, "firstsecondthird");
+
+	const bmstu::list<int> empty;
+	int calls = 0;
+	empty.for_each_prefetch([&calls](const int&) { ++calls; });
+	ASSERT_EQ(calls, 0);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(BidirectLinkedListBench, DISABLED_PushClearChurn)
+{
+	constexpr int kRounds = 10'000;
+	constexpr int kBatch = 1'000;
+	long long pool_sum = 0;
+	long long std_sum = 0;
+
+	bmstu::list<long long> pooled;
+	const double pooled_ms = measure_ms(
+		[&]
+		{
+			for (int round = 0; round < kRounds; ++round)
+			{
+				for (int i = 0; i < kBatch; ++i)
+				{
+					pooled.push_back(i);
+				}
+				pool_sum += pooled.back();
+				pooled.clear();
+			}
+		});
+
+	std::list<long long> standard;
+	const double std_ms = measure_ms(
+		[&]
+		{
+			for (int round = 0; round < kRounds; ++round)
+			{
+				for (int i = 0; i < kBatch; ++i)
+				{
+					standard.push_back(i);
+				}
+				std_sum += standard.back();
+				standard.clear();
+			}
+		});
+	ASSERT_EQ(pool_sum, std_sum);
+
+	const double ops = 2.0 * kRounds * kBatch;
+	std::cout << "push+clear churn: bmstu::list " << ops / pooled_ms / 1e3
+			  << " M ops/s (" << pooled.get_pool()->system_allocations()
+			  << " allocator calls), std::list " << ops / std_ms / 1e3
+			  << " M ops/s (" << static_cast<long long>(kRounds) * kBatch
+			  << " allocator calls)\n";
+}
+
+TEST(BidirectLinkedListBench, DISABLED_SortInPlace)
+{
+	constexpr size_t kSize = 10'000'000;
+	std::mt19937_64 gen(3);
+	bmstu::list<int64_t> relinked;
+	for (size_t i = 0; i < kSize; ++i)
+	{
+		relinked.push_back(static_cast<int64_t>(gen()));
+	}
+	bmstu::list<int64_t> rebuilt(relinked);
+
+	const double relink_ms = measure_ms([&] { relinked.sort(); });
+	size_t rebuild_peak_nodes = 0;
+	const double rebuild_ms = measure_ms(
+		[&]
+		{
+			std::vector<int64_t> values(rebuilt.begin(), rebuilt.end());
+			std::sort(values.begin(), values.end());
+			bmstu::list<int64_t> fresh(values.begin(), values.end());
+			rebuild_peak_nodes = rebuilt.size() + fresh.size();
+			rebuilt = std::move(fresh);
+		});
+	ASSERT_EQ(relinked, rebuilt);
+
+	const double node_mib = sizeof(int64_t[3]) * kSize / 1048576.0;
+	std::cout << "sort 1e7 nodes: in-place relink " << relink_ms
+			  << " ms, extra 0 MiB; copy-sort-rebuild " << rebuild_ms
+			  << " ms, extra "
+			  << (rebuild_peak_nodes - kSize) * sizeof(int64_t[3]) / 1048576.0 +
+					 kSize * sizeof(int64_t) / 1048576.0
+			  << " MiB (list itself " << node_mib << " MiB)\n";
+}
+
+TEST(BidirectLinkedListBench, DISABLED_RandomPositionalAccess)
+{
+	constexpr size_t kSize = 100'000;
+	constexpr size_t kPlainProbes = 2'000;
+	constexpr size_t kIndexedProbes = 1'000'000;
+	bmstu::list<int64_t> plain;
+	bmstu::indexed_list<int64_t> indexed;
+
+	const double plain_push_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kSize; ++i)
+			{
+				plain.push_back(static_cast<int64_t>(i));
+			}
+		});
+	const double indexed_push_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kSize; ++i)
+			{
+				indexed.push_back(static_cast<int64_t>(i));
+			}
+		});
+
+	std::mt19937_64 gen(9);
+	int64_t plain_sum = 0;
+	int64_t indexed_sum = 0;
+	const double plain_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kPlainProbes; ++i)
+			{
+				plain_sum += plain[gen() % kSize];
+			}
+		});
+	gen.seed(9);
+	const double indexed_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kIndexedProbes; ++i)
+			{
+				indexed_sum += indexed[gen() % kSize];
+				if (i + 1 == kPlainProbes)
+				{
+					ASSERT_EQ(indexed_sum, plain_sum);
+				}
+			}
+		});
+
+	std::cout << "operator[] on 1e5 nodes: list "
+			  << plain_ms * 1e6 / kPlainProbes << " ns, indexed_list "
+			  << indexed_ms * 1e6 / kIndexedProbes << " ns; push_back: list "
+			  << plain_push_ms * 1e6 / kSize << " ns, indexed_list "
+			  << indexed_push_ms * 1e6 / kSize << " ns\n";
+}
+
+TEST(BidirectLinkedListBench, DISABLED_StringPayloads)
+{
+	// Строки длиннее буфера SSO: копия всегда идёт в кучу, как у
+	// bmstu::string, который пока не реализован.
+	constexpr size_t kSize = 1'000'000;
+	std::vector<std::string> source(kSize, std::string(64, 'x'));
+
+	bmstu::list<std::string> copied;
+	const double copy_ms = measure_ms(
+		[&]
+		{
+			for (const std::string& s : source)
+			{
+				copied.push_back(s);
+			}
+		});
+	std::vector<std::string> movable(source);
+	bmstu::list<std::string> moved;
+	const double move_ms = measure_ms(
+		[&]
+		{
+			for (std::string& s : movable)
+			{
+				moved.push_back(std::move(s));
+			}
+		});
+	bmstu::list<std::string> emplaced;
+	const double emplace_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kSize; ++i)
+			{
+				emplaced.emplace_back(64, 'x');
+			}
+		});
+	const double pop_ms = measure_ms(
+		[&]
+		{
+			while (!emplaced.empty())
+			{
+				emplaced.pop_front();
+			}
+		});
+	ASSERT_EQ(copied, moved);
+
+	std::cout << "1e6 64-char strings, ns/op: push_back copy "
+			  << copy_ms * 1e6 / kSize << ", push_back move "
+			  << move_ms * 1e6 / kSize << ", emplace_back "
+			  << emplace_ms * 1e6 / kSize << ", pop_front "
+			  << pop_ms * 1e6 / kSize << "\n";
+}
+
+TEST(BidirectLinkedListBench, DISABLED_BulkBuild)
+{
+	constexpr size_t kSize = 5'000'000;
+	std::vector<int64_t> values(kSize);
+	std::iota(values.begin(), values.end(), 0);
+	const int64_t expected = std::accumulate(values.begin(), values.end(),
+											 int64_t{0});
+
+	// Пул, прошедший через случайные удаления: push_back берёт узлы из
+	// перемешанного списка свободных.
+	bmstu::list<int64_t> recycled(values.begin(), values.end());
+	{
+		std::mt19937_64 gen(21);
+		std::vector<bmstu::list<int64_t>::const_iterator> nodes;
+		nodes.reserve(kSize);
+		for (auto it = recycled.cbegin(); it != recycled.cend(); ++it)
+		{
+			nodes.push_back(it);
+		}
+		std::shuffle(nodes.begin(), nodes.end(), gen);
+		for (const auto& it : nodes)
+		{
+			recycled.erase(it);
+		}
+	}
+
+	std::list<int64_t> standard_list;
+	const double std_build_ms = measure_ms(
+		[&] { standard_list.assign(values.begin(), values.end()); });
+	int64_t std_sum = 0;
+	const double std_walk_ms = measure_ms(
+		[&]
+		{
+			std_sum = std::accumulate(standard_list.begin(),
+									  standard_list.end(), int64_t{0});
+		});
+
+	const double push_build_ms = measure_ms(
+		[&]
+		{
+			for (int64_t value : values)
+			{
+				recycled.push_back(value);
+			}
+		});
+	int64_t push_sum = 0;
+	const double push_walk_ms = measure_ms(
+		[&]
+		{
+			push_sum = std::accumulate(recycled.begin(), recycled.end(),
+									   int64_t{0});
+		});
+
+	std::unique_ptr<bmstu::list<int64_t>> bulk;
+	const double bulk_build_ms = measure_ms(
+		[&]
+		{
+			bulk = std::make_unique<bmstu::list<int64_t>>(values.begin(),
+														  values.end());
+		});
+	int64_t bulk_sum = 0;
+	const double bulk_walk_ms = measure_ms(
+		[&]
+		{
+			bulk_sum =
+				std::accumulate(bulk->begin(), bulk->end(), int64_t{0});
+		});
+
+	ASSERT_EQ(std_sum, expected);
+	ASSERT_EQ(push_sum, expected);
+	ASSERT_EQ(bulk_sum, expected);
+	std::cout << "5e6 int64, build / first traversal ms: std::list "
+			  << std_build_ms << " / " << std_walk_ms
+			  << ", push_back into recycled pool " << push_build_ms << " / "
+			  << push_walk_ms << ", bulk slab " << bulk_build_ms << " / "
+			  << bulk_walk_ms << "\n";
+}
+
+TEST(BidirectLinkedListBench, DISABLED_PrefetchTraversal)
+{
+	constexpr size_t kSize = 4'000'000;
+	std::mt19937_64 gen(46);
+	std::vector<int64_t> order(kSize);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), gen);
+	// Узлы создаются подряд, а sort переставляет связи: порядок обхода
+	// становится случайным по памяти.
+	bmstu::list<int64_t> values(order.begin(), order.end());
+	values.sort();
+	std::vector<int64_t> heap(kSize);
+	std::iota(heap.begin(), heap.end(), 0);
+	bmstu::list<const int64_t*> pointers;
+	for (int64_t i : order)
+	{
+		pointers.push_back(&heap[i]);
+	}
+	pointers.sort([](const int64_t* l, const int64_t* r)
+				  { return (*l * 7919) % kSize < (*r * 7919) % kSize; });
+
+	const auto mix = [](int64_t x)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			x ^= x >> 29;
+			x *= 0x9E3779B97F4A7C15;
+		}
+		return x;
+	};
+	const auto run = [&](const char* name, auto plain, auto prefetched)
+	{
+		int64_t expected = 0;
+		const double plain_ms = measure_ms([&] { expected = plain(); });
+		std::cout << name << ", ns/node: range-for "
+				  << plain_ms * 1e6 / kSize;
+		for (size_t distance : {1u, 4u, 8u, 16u, 32u})
+		{
+			int64_t sum = 0;
+			const double ms =
+				measure_ms([&] { sum = prefetched(distance); });
+			ASSERT_EQ(sum, expected);
+			std::cout << ", d=" << distance << " " << ms * 1e6 / kSize;
+		}
+		std::cout << "\n";
+	};
+
+	run(
+		"sum of int64",
+		[&]
+		{
+			int64_t sum = 0;
+			for (int64_t v : values)
+			{
+				sum += v;
+			}
+			return sum;
+		},
+		[&](size_t distance)
+		{
+			int64_t sum = 0;
+			values.for_each_prefetch([&sum](int64_t v) { sum += v; },
+									 distance);
+			return sum;
+		});
+	run(
+		"hash of int64",
+		[&]
+		{
+			int64_t sum = 0;
+			for (int64_t v : values)
+			{
+				sum += mix(v);
+			}
+			return sum;
+		},
+		[&](size_t distance)
+		{
+			int64_t sum = 0;
+			values.for_each_prefetch([&](int64_t v) { sum += mix(v); },
+									 distance);
+			return sum;
+		});
+	run(
+		"sum through pointers",
+		[&]
+		{
+			int64_t sum = 0;
+			for (const int64_t* p : pointers)
+			{
+				sum += *p;
+			}
+			return sum;
+		},
+		[&](size_t distance)
+		{
+			int64_t sum = 0;
+			pointers.for_each_prefetch(
+				[&sum](const int64_t* p) { sum += *p; }, distance,
+				[](const int64_t* p) { return p; });
+			return sum;
+		});
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace bmstu
+{
+// Пул узлов одного типа: память берётся у системы крупными слэбами, а
+// освобождённые узлы складываются в односвязный список свободных и
+// переиспользуются. Пул отдаёт сырую память — конструировать и разрушать
+// объекты должен вызывающий. Не потокобезопасен.
+template <typename Node>
+class node_pool
+{
+	union slot
+	{
+		slot* next;
+		alignas(Node) unsigned char storage[sizeof(Node)];
+	};
+
+	struct slab
+	{
+		slab* next;
+		size_t count;
+	};
+
+	static constexpr size_t kAlign = std::max(alignof(slot), alignof(slab));
+	static constexpr size_t kHeaderBytes =
+		(sizeof(slab) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+
+   public:
+	static constexpr size_t kFirstSlab = 8;
+	static constexpr size_t kMaxSlab = 4096;
+
+	node_pool() = default;
+
+	node_pool(const node_pool& other) = delete;
+	node_pool& operator=(const node_pool& other) = delete;
+
+	~node_pool() { release(); }
+
+	// Память под один узел.
+	Node* allocate()
+	{
+		if (free_ != nullptr)
+		{
+			slot* s = free_;
+			free_ = s->next;
+			return reinterpret_cast<Node*>(s);
+		}
+		if (bump_ == bump_end_)
+		{
+			bump_ = new_slab_(next_slab_);
+			bump_end_ = bump_ + next_slab_;
+			next_slab_ = std::min(next_slab_ * 2, kMaxSlab);
+		}
+		return reinterpret_cast<Node*>(bump_++);
+	}
+
+	void deallocate(Node* node) noexcept
+	{
+		slot* s = reinterpret_cast<slot*>(node);
+		s->next = free_;
+		free_ = s;
+	}
+
+	// Отдельный слэб ровно под count узлов, лежащих подряд: результат можно
+	// индексировать как массив Node. Узлы из него освобождаются обычным
+	// deallocate, а сам слэб — вместе с остальными в release().
+	Node* allocate_bulk(size_t count)
+	{
+		static_assert(sizeof(slot) == sizeof(Node),
+					  "bulk nodes are addressed as a Node array");
+		return reinterpret_cast<Node*>(new_slab_(count));
+	}
+
+	// Возвращает все слэбы системе за O(число слэбов). Живые объекты в них
+	// должны быть разрушены заранее.
+	void release() noexcept
+	{
+		while (slabs_ != nullptr)
+		{
+			slab* next = slabs_->next;
+			::operator delete(slabs_, std::align_val_t{kAlign});
+			slabs_ = next;
+		}
+		free_ = nullptr;
+		bump_ = nullptr;
+		bump_end_ = nullptr;
+		next_slab_ = kFirstSlab;
+		capacity_ = 0;
+		slab_count_ = 0;
+	}
+
+	// Сколько узлов вмещают все слэбы.
+	size_t capacity() const noexcept { return capacity_; }
+
+	size_t slab_count() const noexcept { return slab_count_; }
+
+	// Сколько раз пул обращался к системному аллокатору за всё время.
+	size_t system_allocations() const noexcept { return system_allocations_; }
+
+   private:
+	slot* new_slab_(size_t count)
+	{
+		void* memory = ::operator new(kHeaderBytes + count * sizeof(slot),
+									  std::align_val_t{kAlign});
+		slab* header = static_cast<slab*>(memory);
+		header->next = slabs_;
+		header->count = count;
+		slabs_ = header;
+		capacity_ += count;
+		++slab_count_;
+		++system_allocations_;
+		return reinterpret_cast<slot*>(static_cast<unsigned char*>(memory) +
+									   kHeaderBytes);
+	}
+
+	slab* slabs_ = nullptr;
+	slot* free_ = nullptr;
+	slot* bump_ = nullptr;
+	slot* bump_end_ = nullptr;
+	size_t next_slab_ = kFirstSlab;
+	size_t capacity_ = 0;
+	size_t slab_count_ = 0;
+	size_t system_allocations_ = 0;
+};
+}  // namespace bmstu
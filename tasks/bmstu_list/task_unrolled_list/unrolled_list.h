@@ -0,0 +1,568 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "abstract_iterator.h"
+#include "node_pool.h"
+
+namespace bmstu
+{
+namespace detail
+{
+// Вместимость узла по умолчанию: около 256 байт полезных данных, но не
+// меньше восьми элементов.
+template <typename T>
+constexpr size_t unrolled_node_capacity()
+{
+	return std::max<size_t>(8, 256 / sizeof(T));
+}
+}  // namespace detail
+
+// Развёрнутый список: каждый узел хранит до NodeCapacity элементов подряд,
+// поэтому обход — один переход по указателю на узел, а не на элемент.
+// Вставка и удаление у итератора — O(NodeCapacity): переполненный узел
+// делится пополам, узел, опустевший меньше чем наполовину, сливается с
+// соседями, если их элементы помещаются в один узел.
+// insert и erase делают недействительными итераторы на элементы того узла,
+// который менялся, и соседнего узла при делении или слиянии.
+template <typename T, size_t NodeCapacity = detail::unrolled_node_capacity<T>()>
+class unrolled_list
+{
+	static_assert(NodeCapacity >= 2, "node must hold at least two elements");
+
+	struct node_base
+	{
+		node_base* next = nullptr;
+		node_base* prev = nullptr;
+		size_t count = 0;
+	};
+
+	struct node : node_base
+	{
+		T* elements() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(storage));
+		}
+
+		alignas(T) unsigned char storage[NodeCapacity * sizeof(T)];
+	};
+
+	template <bool Const>
+	class basic_iterator final
+		: public abstract_iterator<basic_iterator<Const>,
+								   std::conditional_t<Const, const T, T>,
+								   std::bidirectional_iterator_tag>
+	{
+		using base = abstract_iterator<basic_iterator<Const>,
+									   std::conditional_t<Const, const T, T>,
+									   std::bidirectional_iterator_tag>;
+		friend class unrolled_list;
+
+	   public:
+		using typename base::difference_type;
+		using typename base::pointer;
+		using typename base::reference;
+
+		basic_iterator() = default;
+
+		basic_iterator(node_base* node, size_t index) noexcept
+			: node_(node), index_(index)
+		{
+		}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(node_, index_);
+		}
+
+		reference operator*() const override
+		{
+			return static_cast<node*>(node_)->elements()[index_];
+		}
+
+		pointer operator->() const override
+		{
+			return static_cast<node*>(node_)->elements() + index_;
+		}
+
+		basic_iterator& operator++() override
+		{
+			if (++index_ == node_->count)
+			{
+				node_ = node_->next;
+				index_ = 0;
+			}
+			return *this;
+		}
+
+		basic_iterator operator++(int) override
+		{
+			basic_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		basic_iterator& operator--() override
+		{
+			if (index_ == 0)
+			{
+				node_ = node_->prev;
+				index_ = node_->count;
+			}
+			--index_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) override
+		{
+			basic_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		// Целые узлы пропускаются по счётчику, а не поэлементно.
+		basic_iterator& operator+=(const difference_type& n) override
+		{
+			if (n >= 0)
+			{
+				size_t rest = static_cast<size_t>(n);
+				while (rest > 0 && index_ + rest >= node_->count &&
+					   node_->count != 0)
+				{
+					rest -= node_->count - index_;
+					node_ = node_->next;
+					index_ = 0;
+				}
+				index_ += rest;
+			}
+			else
+			{
+				size_t rest = static_cast<size_t>(-n);
+				while (rest > index_)
+				{
+					rest -= index_ + 1;
+					node_ = node_->prev;
+					index_ = node_->count - 1;
+				}
+				index_ -= rest;
+			}
+			return *this;
+		}
+
+		basic_iterator& operator-=(const difference_type& n) override
+		{
+			return *this += -n;
+		}
+
+		basic_iterator operator+(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		basic_iterator operator-(const difference_type& n) const override
+		{
+			basic_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		// Число шагов вперёд от other до *this; other не должен стоять после
+		// *this.
+		difference_type operator-(const basic_iterator& other) const override
+		{
+			difference_type count = -static_cast<difference_type>(other.index_);
+			for (node_base* it = other.node_; it != node_; it = it->next)
+			{
+				count += it->count;
+			}
+			return count + index_;
+		}
+
+		bool operator==(const basic_iterator& other) const override
+		{
+			return node_ == other.node_ && index_ == other.index_;
+		}
+
+		bool operator!=(const basic_iterator& other) const override
+		{
+			return !(*this == other);
+		}
+
+		explicit operator bool() const override { return node_ != nullptr; }
+
+	   private:
+		node_base* node_ = nullptr;
+		size_t index_ = 0;
+	};
+
+   public:
+	using value_type = T;
+	using pool_type = node_pool<node>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	static constexpr size_t node_capacity = NodeCapacity;
+
+	unrolled_list() noexcept { reset_links_(); }
+
+	template <typename It>
+	unrolled_list(It first, It last) : unrolled_list()
+	{
+		for (; first != last; ++first)
+		{
+			push_back(*first);
+		}
+	}
+
+	unrolled_list(std::initializer_list<T> values)
+		: unrolled_list(values.begin(), values.end())
+	{
+	}
+
+	unrolled_list(const unrolled_list& other)
+		: unrolled_list(other.begin(), other.end())
+	{
+	}
+
+	unrolled_list(unrolled_list&& other) noexcept : unrolled_list()
+	{
+		swap(other);
+	}
+
+	~unrolled_list() { clear(); }
+
+	unrolled_list& operator=(const unrolled_list& other)
+	{
+		if (this != &other)
+		{
+			unrolled_list tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	unrolled_list& operator=(unrolled_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			unrolled_list tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	size_t size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	// Число узлов; слияние при удалении держит его около n / NodeCapacity.
+	size_t node_count() const noexcept { return node_count_; }
+
+	void clear() noexcept
+	{
+		node_base* current = sentinel_.next;
+		while (current != &sentinel_)
+		{
+			node_base* next = current->next;
+			node* n = static_cast<node*>(current);
+			std::destroy_n(n->elements(), n->count);
+			pool_->deallocate(n);
+			current = next;
+		}
+		reset_links_();
+		size_ = 0;
+		node_count_ = 0;
+	}
+
+	void swap(unrolled_list& other) noexcept
+	{
+		std::swap(sentinel_, other.sentinel_);
+		std::swap(size_, other.size_);
+		std::swap(node_count_, other.node_count_);
+		pool_.swap(other.pool_);
+		fix_links_();
+		other.fix_links_();
+	}
+
+	friend void swap(unrolled_list& l, unrolled_list& r) noexcept
+	{
+		l.swap(r);
+	}
+
+	iterator begin() noexcept { return iterator(sentinel_.next, 0); }
+
+	iterator end() noexcept { return iterator(&sentinel_, 0); }
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(sentinel_.next, 0);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(end_node_(), 0);
+	}
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+	T& front() noexcept { return *begin(); }
+
+	const T& front() const noexcept { return *begin(); }
+
+	T& back() noexcept { return *--end(); }
+
+	const T& back() const noexcept { return *--end(); }
+
+	void push_back(const T& value) { insert(cend(), value); }
+
+	void push_front(const T& value) { insert(cbegin(), value); }
+
+	void pop_back() noexcept { erase(--cend()); }
+
+	void pop_front() noexcept { erase(cbegin()); }
+
+	// Вставка перед pos. Если узел полон, он делится пополам.
+	iterator insert(const_iterator pos, const T& value)
+	{
+		if (pos.node_ != &sentinel_ && pos.node_->count == NodeCapacity)
+		{
+			// Деление переносит половину узла, а value может ссылаться на
+			// его элемент, поэтому копия делается заранее.
+			return insert_(pos, T(value));
+		}
+		return insert_(pos, value);
+	}
+
+	// Удаляет элемент и возвращает итератор на следующий.
+	iterator erase(const_iterator pos) noexcept
+	{
+		node* target = static_cast<node*>(pos.node_);
+		const size_t index = pos.index_;
+		T* elements = target->elements();
+		std::move(elements + index + 1, elements + target->count,
+				  elements + index);
+		std::destroy_at(elements + target->count - 1);
+		--target->count;
+		--size_;
+
+		if (target->count == 0)
+		{
+			node_base* next = target->next;
+			destroy_node_(target);
+			return iterator(next, 0);
+		}
+		node* at = target;
+		size_t at_index = index;
+		if (target->count < NodeCapacity / 2)
+		{
+			merge_next_(target);
+			node* prev = static_cast<node*>(target->prev);
+			const size_t offset = prev->count;
+			if (target->prev != &sentinel_ && merge_next_(prev))
+			{
+				at = prev;
+				at_index += offset;
+			}
+		}
+		if (at_index < at->count)
+		{
+			return iterator(at, at_index);
+		}
+		return iterator(at->next, 0);
+	}
+
+	T& operator[](size_t pos) noexcept { return *(begin() + pos); }
+
+	const T& operator[](size_t pos) const noexcept
+	{
+		return *(begin() + pos);
+	}
+
+	friend bool operator==(const unrolled_list& l, const unrolled_list& r)
+	{
+		return l.size_ == r.size_ && std::equal(l.begin(), l.end(), r.begin());
+	}
+
+	friend bool operator!=(const unrolled_list& l, const unrolled_list& r)
+	{
+		return !(l == r);
+	}
+
+	friend std::ostream& operator<<(std::ostream& os,
+									const unrolled_list& other)
+	{
+		os << "{";
+		for (auto it = other.begin(); it != other.end(); ++it)
+		{
+			if (it != other.begin())
+			{
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os << "}";
+	}
+
+   private:
+	static_assert(std::is_nothrow_move_constructible_v<T> &&
+					  std::is_nothrow_move_assignable_v<T>,
+				  "elements are shifted inside nodes by moves");
+
+	node_base* end_node_() const noexcept
+	{
+		return const_cast<node_base*>(&sentinel_);
+	}
+
+	void reset_links_() noexcept
+	{
+		sentinel_.next = &sentinel_;
+		sentinel_.prev = &sentinel_;
+		sentinel_.count = 0;
+	}
+
+	void fix_links_() noexcept
+	{
+		if (size_ == 0)
+		{
+			reset_links_();
+			return;
+		}
+		sentinel_.next->prev = &sentinel_;
+		sentinel_.prev->next = &sentinel_;
+	}
+
+	// Пустой узел перед pos.
+	node* create_node_(node_base* pos)
+	{
+		if (!pool_)
+		{
+			pool_ = std::make_unique<pool_type>();
+		}
+		node* n = ::new (static_cast<void*>(pool_->allocate())) node;
+		n->next = pos;
+		n->prev = pos->prev;
+		pos->prev->next = n;
+		pos->prev = n;
+		++node_count_;
+		return n;
+	}
+
+	// Узел должен быть пустым.
+	void destroy_node_(node* n) noexcept
+	{
+		n->prev->next = n->next;
+		n->next->prev = n->prev;
+		pool_->deallocate(n);
+		--node_count_;
+	}
+
+	// Переносит верхнюю половину полного узла в новый узел за ним.
+	node_base* split_(node* full)
+	{
+		node* upper = create_node_(full->next);
+		const size_t keep = NodeCapacity / 2;
+		T* from = full->elements();
+		std::uninitialized_move(from + keep, from + NodeCapacity,
+								upper->elements());
+		std::destroy(from + keep, from + NodeCapacity);
+		upper->count = NodeCapacity - keep;
+		full->count = keep;
+		return upper;
+	}
+
+	// Забирает элементы следующего узла, если они помещаются целиком.
+	bool merge_next_(node* n) noexcept
+	{
+		if (n->next == &sentinel_ || n->count + n->next->count > NodeCapacity)
+		{
+			return false;
+		}
+		node* next = static_cast<node*>(n->next);
+		std::uninitialized_move(next->elements(),
+								next->elements() + next->count,
+								n->elements() + n->count);
+		std::destroy_n(next->elements(), next->count);
+		n->count += next->count;
+		next->count = 0;
+		destroy_node_(next);
+		return true;
+	}
+
+	template <typename U>
+	iterator insert_(const_iterator pos, U&& value)
+	{
+		node_base* target = pos.node_;
+		size_t index = pos.index_;
+		if (target == &sentinel_)
+		{
+			// Вставка в конец дописывает в последний узел, пока есть место.
+			target = sentinel_.prev;
+			index = target->count;
+			if (target == &sentinel_ || index == NodeCapacity)
+			{
+				target = create_node_(&sentinel_);
+				index = 0;
+			}
+		}
+		else if (target->count == NodeCapacity)
+		{
+			node_base* upper = split_(static_cast<node*>(target));
+			if (index > target->count)
+			{
+				index -= target->count;
+				target = upper;
+			}
+		}
+		try
+		{
+			insert_into_(static_cast<node*>(target), index,
+						 std::forward<U>(value));
+		}
+		catch (...)
+		{
+			if (target->count == 0)
+			{
+				destroy_node_(static_cast<node*>(target));
+			}
+			throw;
+		}
+		++size_;
+		return iterator(target, index);
+	}
+
+	template <typename U>
+	void insert_into_(node* n, size_t index, U&& value)
+	{
+		T* elements = n->elements();
+		if (index == n->count)
+		{
+			std::construct_at(elements + index, std::forward<U>(value));
+		}
+		else
+		{
+			// Копия делается до сдвига: value может ссылаться в этот узел.
+			T copy(std::forward<U>(value));
+			std::construct_at(elements + n->count,
+							  std::move(elements[n->count - 1]));
+			std::move_backward(elements + index, elements + n->count - 1,
+							   elements + n->count);
+			elements[index] = std::move(copy);
+		}
+		++n->count;
+	}
+
+	std::unique_ptr<pool_type> pool_;
+	node_base sentinel_;
+	size_t size_ = 0;
+	size_t node_count_ = 0;
+};
+}  // namespace bmstu
@@ -0,0 +1,358 @@
+#include "unrolled_list.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "bmstu_list.h"
+
+namespace
+{
+template <typename List>
+std::vector<typename List::value_type> to_vector(const List& list)
+{
+	return {list.begin(), list.end()};
+}
+}  // namespace
+
+TEST(UnrolledListTest, Empty)
+{
+	bmstu::unrolled_list<int> list;
+	ASSERT_TRUE(list.empty());
+	ASSERT_EQ(list.size(), 0u);
+	ASSERT_EQ(list.node_count(), 0u);
+	ASSERT_EQ(list.begin(), list.end());
+	ASSERT_EQ(list.cbegin(), list.cend());
+}
+
+TEST(UnrolledListTest, PushFillsNodes)
+{
+	bmstu::unrolled_list<int, 4> list;
+	for (int i = 0; i < 10; ++i)
+	{
+		list.push_back(i);
+	}
+	ASSERT_EQ(list.size(), 10u);
+	ASSERT_EQ(list.node_count(), 3u);
+	ASSERT_EQ(list.front(), 0);
+	ASSERT_EQ(list.back(), 9);
+	list.push_front(-1);
+	ASSERT_EQ(list.front(), -1);
+	ASSERT_EQ(list[5], 4);
+	std::stringstream out;
+	out << list;
+	ASSERT_EQ(out.str(), "{-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}");
+}
+
+TEST(UnrolledListTest, IteratorArithmetic)
+{
+	bmstu::unrolled_list<int, 4> list;
+	for (int i = 0; i < 20; ++i)
+	{
+		list.push_back(i);
+	}
+	auto it = list.begin();
+	for (int step = 0; step <= 20; ++step)
+	{
+		ASSERT_EQ(list.begin() + step - list.begin(), step);
+		if (step < 20)
+		{
+			ASSERT_EQ(*(list.begin() + step), step);
+			ASSERT_EQ(*(list.end() - (20 - step)), step);
+		}
+	}
+	ASSERT_EQ(list.begin() + 20, list.end());
+	ASSERT_EQ(std::distance(list.begin(), list.end()), 20);
+	it += 7;
+	it -= 3;
+	ASSERT_EQ(*it, 4);
+	ASSERT_EQ(*--list.end(), 19);
+	ASSERT_EQ(*(it++), 4);
+	ASSERT_EQ(*it, 5);
+}
+
+TEST(UnrolledListTest, InsertSplitsFullNode)
+{
+	bmstu::unrolled_list<int, 4> list{0, 1, 2, 3};
+	ASSERT_EQ(list.node_count(), 1u);
+	auto it = list.insert(list.cbegin() + 1, 100);
+	ASSERT_EQ(*it, 100);
+	ASSERT_EQ(list.node_count(), 2u);
+	ASSERT_EQ(to_vector(list), (std::vector<int>{0, 100, 1, 2, 3}));
+
+	it = list.insert(list.cbegin() + 4, 200);
+	ASSERT_EQ(*it, 200);
+	ASSERT_EQ(*++it, 3);
+	ASSERT_EQ(to_vector(list), (std::vector<int>{0, 100, 1, 2, 200, 3}));
+}
+
+TEST(UnrolledListTest, EraseMergesNodes)
+{
+	bmstu::unrolled_list<int, 4> list;
+	for (int i = 0; i < 12; ++i)
+	{
+		list.push_back(i);
+	}
+	ASSERT_EQ(list.node_count(), 3u);
+	auto it = list.erase(list.cbegin() + 1);
+	ASSERT_EQ(*it, 2);
+	it = list.erase(it);
+	ASSERT_EQ(*it, 3);
+	ASSERT_EQ(list.node_count(), 3u);
+	it = list.erase(it);
+	ASSERT_EQ(*it, 4);
+	ASSERT_EQ(list.node_count(), 3u);
+
+	// Средний узел опускается до одного элемента и уходит в первый.
+	it = list.erase(list.cbegin() + 1);
+	it = list.erase(it);
+	it = list.erase(it);
+	ASSERT_EQ(*it, 7);
+	ASSERT_EQ(list.node_count(), 2u);
+	ASSERT_EQ(to_vector(list), (std::vector<int>{0, 7, 8, 9, 10, 11}));
+
+	while (!list.empty())
+	{
+		list.pop_back();
+	}
+	ASSERT_EQ(list.node_count(), 0u);
+	ASSERT_EQ(list.begin(), list.end());
+}
+
+TEST(UnrolledListTest, MatchesStdListOnRandomEdits)
+{
+	std::mt19937 gen(42);
+	bmstu::unrolled_list<std::string, 5> list;
+	std::list<std::string> expected;
+	for (int step = 0; step < 5000; ++step)
+	{
+		const size_t pos =
+			expected.empty() ? 0 : gen() % (expected.size() + 1);
+		if (gen() % 3 != 0 || expected.empty())
+		{
+			const std::string value = std::to_string(step);
+			list.insert(list.cbegin() + pos, value);
+			expected.insert(std::next(expected.begin(), pos), value);
+		}
+		else
+		{
+			const size_t victim = pos % expected.size();
+			auto it = list.erase(list.cbegin() + victim);
+			auto expected_it =
+				expected.erase(std::next(expected.begin(), victim));
+			ASSERT_EQ(it == list.end(), expected_it == expected.end());
+			if (it != list.end())
+			{
+				ASSERT_EQ(*it, *expected_it);
+			}
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	ASSERT_TRUE(std::equal(list.begin(), list.end(), expected.begin(),
+						   expected.end()));
+	ASSERT_LE(list.node_count(), 2 * list.size() / 5 + 1);
+}
+
+TEST(UnrolledListTest, CopyMoveSwap)
+{
+	bmstu::unrolled_list<std::string, 3> first{"a", "b", "c", "d"};
+	bmstu::unrolled_list<std::string, 3> copy(first);
+	ASSERT_EQ(copy, first);
+	bmstu::unrolled_list<std::string, 3> moved(std::move(first));
+	ASSERT_TRUE(first.empty());
+	ASSERT_EQ(moved, copy);
+	ASSERT_EQ(*--moved.end(), "d");
+
+	bmstu::unrolled_list<std::string, 3> other{"x"};
+	swap(other, moved);
+	ASSERT_EQ(other, copy);
+	ASSERT_EQ(moved.size(), 1u);
+	moved = other;
+	ASSERT_EQ(moved, other);
+	other = bmstu::unrolled_list<std::string, 3>{};
+	ASSERT_TRUE(other.empty());
+	other.push_back("again");
+	ASSERT_EQ(other.front(), "again");
+}
+
+TEST(UnrolledListTest, SelfInsertAliasing)
+{
+	bmstu::unrolled_list<std::string, 4> list{"zero", "one", "two"};
+	list.insert(list.cbegin(), list.back());
+	ASSERT_EQ(to_vector(list),
+			  (std::vector<std::string>{"two", "zero", "one", "two"}));
+}
+
+TEST(UnrolledListTest, SelfInsertIntoFullNode)
+{
+	// Строки длинные, чтобы перемещённая строка оставалась пустой.
+	const std::string a(64, 'a');
+	const std::string b(64, 'b');
+	const std::string c(64, 'c');
+	const std::string d(64, 'd');
+	bmstu::unrolled_list<std::string, 4> list{a, b, c, d};
+	ASSERT_EQ(list.node_count(), 1u);
+	list.insert(list.cbegin() + 1, list.back());
+	ASSERT_EQ(list.node_count(), 2u);
+	ASSERT_EQ(to_vector(list), (std::vector<std::string>{a, d, b, c, d}));
+	list.insert(list.cbegin() + 4, list.front());
+	ASSERT_EQ(to_vector(list), (std::vector<std::string>{a, d, b, c, a, d}));
+}
+
+TEST(UnrolledListTest, ThrowingCopyLeavesListIntact)
+{
+	struct ThrowOnCopy
+	{
+		ThrowOnCopy() = default;
+		ThrowOnCopy(const ThrowOnCopy& other) : armed(other.armed)
+		{
+			if (armed)
+			{
+				throw std::bad_alloc();
+			}
+		}
+		ThrowOnCopy(ThrowOnCopy&&) noexcept = default;
+		ThrowOnCopy& operator=(ThrowOnCopy&&) noexcept = default;
+		bool armed = false;
+	};
+
+	bmstu::unrolled_list<ThrowOnCopy, 2> list;
+	list.push_back(ThrowOnCopy{});
+	list.push_back(ThrowOnCopy{});
+	ThrowOnCopy bomb;
+	bomb.armed = true;
+	ASSERT_THROW(list.push_back(bomb), std::bad_alloc);
+	ASSERT_EQ(list.size(), 2u);
+	ASSERT_EQ(list.node_count(), 1u);
+	ASSERT_EQ(list.end() - list.begin(), 2);
+}
+
+namespace
+{
+using bmstu::bench::measure_ms;
+
+// Заполняет список в случайном порядке вставок, чтобы узлы лежали в памяти
+// вперемешку, как после долгой работы.
+template <typename List>
+void fill_scattered(List& list, size_t n)
+{
+	std::mt19937 gen(7);
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (gen() % 2 == 0)
+		{
+			list.push_back(static_cast<int64_t>(i));
+		}
+		else
+		{
+			list.push_front(static_cast<int64_t>(i));
+		}
+	}
+}
+}  // namespace
+
+TEST(UnrolledListBench, DISABLED_Traversal)
+{
+	constexpr size_t kSize = 4'000'000;
+	constexpr int kPasses = 5;
+	bmstu::unrolled_list<int64_t> unrolled;
+	bmstu::list<int64_t> linked;
+	std::vector<int64_t> vector;
+	fill_scattered(unrolled, kSize);
+	fill_scattered(linked, kSize);
+	vector.assign(unrolled.begin(), unrolled.end());
+
+	int64_t sums[3] = {};
+	const double unrolled_ms = measure_ms(
+		[&]
+		{
+			for (int pass = 0; pass < kPasses; ++pass)
+			{
+				sums[0] += std::accumulate(unrolled.begin(), unrolled.end(),
+										   int64_t{0});
+			}
+		});
+	const double linked_ms = measure_ms(
+		[&]
+		{
+			for (int pass = 0; pass < kPasses; ++pass)
+			{
+				sums[1] +=
+					std::accumulate(linked.begin(), linked.end(), int64_t{0});
+			}
+		});
+	const double vector_ms = measure_ms(
+		[&]
+		{
+			for (int pass = 0; pass < kPasses; ++pass)
+			{
+				sums[2] +=
+					std::accumulate(vector.begin(), vector.end(), int64_t{0});
+			}
+		});
+	ASSERT_EQ(sums[0], sums[1]);
+	ASSERT_EQ(sums[0], sums[2]);
+
+	const double elements = static_cast<double>(kSize) * kPasses;
+	std::cout << "traversal ns/element: unrolled_list "
+			  << unrolled_ms * 1e6 / elements << ", bmstu::list "
+			  << linked_ms * 1e6 / elements << ", std::vector "
+			  << vector_ms * 1e6 / elements << "\n";
+}
+
+TEST(UnrolledListBench, DISABLED_MiddleInsert)
+{
+	// Итератор на середину держится между вставками, как при слиянии
+	// потоков: списку не нужно его искать, вектору приходится сдвигать хвост.
+	constexpr size_t kInitial = 200'000;
+	constexpr size_t kInserts = 50'000;
+	std::vector<int64_t> initial(kInitial);
+	std::iota(initial.begin(), initial.end(), 0);
+
+	bmstu::unrolled_list<int64_t> unrolled(initial.begin(), initial.end());
+	bmstu::list<int64_t> linked(initial.begin(), initial.end());
+	std::vector<int64_t> vector(initial);
+
+	const double unrolled_ms = measure_ms(
+		[&]
+		{
+			auto it = unrolled.cbegin() + kInitial / 2;
+			for (size_t i = 0; i < kInserts; ++i)
+			{
+				it = unrolled.insert(it, static_cast<int64_t>(i));
+			}
+		});
+	const double linked_ms = measure_ms(
+		[&]
+		{
+			auto it = linked.cbegin() + kInitial / 2;
+			for (size_t i = 0; i < kInserts; ++i)
+			{
+				it = linked.insert(it, static_cast<int64_t>(i));
+			}
+		});
+	const double vector_ms = measure_ms(
+		[&]
+		{
+			auto it = vector.begin() + kInitial / 2;
+			for (size_t i = 0; i < kInserts; ++i)
+			{
+				it = vector.insert(it, static_cast<int64_t>(i));
+			}
+		});
+	ASSERT_TRUE(std::equal(unrolled.begin(), unrolled.end(), vector.begin(),
+						   vector.end()));
+	ASSERT_TRUE(std::equal(linked.begin(), linked.end(), vector.begin(),
+						   vector.end()));
+
+	std::cout << "middle insert ns/op: unrolled_list "
+			  << unrolled_ms * 1e6 / kInserts << ", bmstu::list "
+			  << linked_ms * 1e6 / kInserts << ", std::vector "
+			  << vector_ms * 1e6 / kInserts << "\n";
+}
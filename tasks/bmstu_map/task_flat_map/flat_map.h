@@ -0,0 +1,546 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+namespace detail
+{
+// lower_bound без ветвлений в цикле: сравнение превращается в cmov, и число
+// итераций зависит только от n, поэтому нет ошибок предсказания переходов.
+template <typename K, typename Compare>
+size_t branchless_lower_bound(const K* base,
+							  size_t n,
+							  const K& key,
+							  const Compare& comp)
+{
+	if (n == 0)
+	{
+		return 0;
+	}
+	const K* first = base;
+	while (n > 1)
+	{
+		const size_t half = n / 2;
+		first = comp(first[half], key) ? first + half : first;
+		n -= half;
+	}
+	return static_cast<size_t>(first - base) + comp(*first, key);
+}
+
+// Сортирует пачку по ключу и оставляет по одному элементу на ключ: из
+// равных побеждает последний (как при последовательных вставках).
+template <typename T, typename Key, typename Compare>
+void sort_unique_last(simple_vector<T>& items, Key key, const Compare& comp)
+{
+	std::stable_sort(items.begin(), items.end(),
+					 [&](const T& lhs, const T& rhs)
+					 { return comp(key(lhs), key(rhs)); });
+	size_t out = 0;
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		if (i + 1 < items.size() && !comp(key(items[i]), key(items[i + 1])))
+		{
+			continue;
+		}
+		if (out != i)
+		{
+			items[out] = std::move(items[i]);
+		}
+		++out;
+	}
+	items.resize(out);
+}
+}  // namespace detail
+
+// Отсортированное множество в одном непрерывном simple_vector. Поиск —
+// бинарный без ветвлений, вставка одного ключа — O(n), пачки вливаются за
+// один проход слиянием.
+template <typename K, typename Compare = std::less<K>>
+class flat_set
+{
+   public:
+	using key_type = K;
+	using value_type = K;
+	using const_iterator = typename simple_vector<K>::const_iterator;
+	using iterator = const_iterator;
+
+	flat_set() = default;
+
+	// Массовое построение: sort + unique.
+	explicit flat_set(simple_vector<K> keys, Compare comp = {})
+		: keys_(std::move(keys)), comp_(std::move(comp))
+	{
+		detail::sort_unique_last(keys_, std::identity{}, comp_);
+	}
+
+	flat_set(std::initializer_list<K> init)
+		: flat_set(simple_vector<K>(init))
+	{
+	}
+
+	size_t size() const noexcept { return keys_.size(); }
+
+	bool empty() const noexcept { return keys_.empty(); }
+
+	void reserve(size_t capacity) { keys_.reserve(capacity); }
+
+	void clear() noexcept { keys_.clear(); }
+
+	const_iterator begin() const noexcept { return keys_.cbegin(); }
+
+	const_iterator end() const noexcept { return keys_.cend(); }
+
+	std::span<const K> keys() const noexcept
+	{
+		return {keys_.data(), keys_.size()};
+	}
+
+	const_iterator lower_bound(const K& key) const
+	{
+		return begin() + index_of_(key);
+	}
+
+	const_iterator find(const K& key) const
+	{
+		const size_t i = index_of_(key);
+		return found_(i, key) ? begin() + i : end();
+	}
+
+	bool contains(const K& key) const { return found_(index_of_(key), key); }
+
+	size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+	// true, если ключа ещё не было.
+	bool insert(const K& key)
+	{
+		const size_t i = index_of_(key);
+		if (found_(i, key))
+		{
+			return false;
+		}
+		keys_.insert(begin() + i, key);
+		return true;
+	}
+
+	// Вливает пачку за один проход: O(size() + m log m).
+	void insert(simple_vector<K> batch)
+	{
+		detail::sort_unique_last(batch, std::identity{}, comp_);
+		simple_vector<K> merged;
+		merged.reserve(keys_.size() + batch.size());
+		size_t i = 0;
+		size_t j = 0;
+		while (i < keys_.size() && j < batch.size())
+		{
+			if (comp_(keys_[i], batch[j]))
+			{
+				merged.push_back(std::move(keys_[i++]));
+			}
+			else if (comp_(batch[j], keys_[i]))
+			{
+				merged.push_back(std::move(batch[j++]));
+			}
+			else
+			{
+				merged.push_back(std::move(keys_[i++]));
+				++j;
+			}
+		}
+		for (; i < keys_.size(); ++i)
+		{
+			merged.push_back(std::move(keys_[i]));
+		}
+		for (; j < batch.size(); ++j)
+		{
+			merged.push_back(std::move(batch[j]));
+		}
+		keys_.swap(merged);
+	}
+
+	bool erase(const K& key)
+	{
+		const size_t i = index_of_(key);
+		if (!found_(i, key))
+		{
+			return false;
+		}
+		keys_.erase(begin() + i);
+		return true;
+	}
+
+	friend bool operator==(const flat_set& lhs, const flat_set& rhs)
+	{
+		return lhs.keys_ == rhs.keys_;
+	}
+
+   private:
+	size_t index_of_(const K& key) const
+	{
+		return detail::branchless_lower_bound(keys_.data(), keys_.size(), key,
+											  comp_);
+	}
+
+	bool found_(size_t i, const K& key) const
+	{
+		return i < keys_.size() && !comp_(key, keys_[i]);
+	}
+
+	simple_vector<K> keys_;
+	[[no_unique_address]] Compare comp_;
+};
+
+// Отсортированный словарь: ключи и значения лежат в двух параллельных
+// simple_vector, поэтому бинарный поиск читает только массив ключей. Вставка
+// существующего ключа перезаписывает значение, как в bmstu::map.
+template <typename K, typename V, typename Compare = std::less<K>>
+class flat_map
+{
+	template <bool Const>
+	class basic_iterator
+	{
+		using owner = std::conditional_t<Const, const flat_map, flat_map>;
+
+	   public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = std::pair<K, V>;
+		using difference_type = std::ptrdiff_t;
+		using reference =
+			std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+		// operator-> отдаёт временную пару ссылок.
+		struct pointer
+		{
+			reference ref;
+
+			reference* operator->() noexcept { return &ref; }
+		};
+
+		basic_iterator() = default;
+
+		basic_iterator(owner* map, size_t index) noexcept
+			: map_(map), index_(index)
+		{
+		}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(map_, index_);
+		}
+
+		reference operator*() const
+		{
+			return reference(map_->keys_[index_], map_->values_[index_]);
+		}
+
+		pointer operator->() const { return pointer{**this}; }
+
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		size_t index() const noexcept { return index_; }
+
+		basic_iterator& operator++() noexcept
+		{
+			++index_;
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			--index_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			index_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			index_ -= n;
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.index_) -
+				   static_cast<difference_type>(rhs.index_);
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ == rhs.index_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ <=> rhs.index_;
+		}
+
+	   private:
+		owner* map_ = nullptr;
+		size_t index_ = 0;
+	};
+
+   public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<K, V>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	flat_map() = default;
+
+	// Массовое построение: сортировка пар и удаление повторов ключей.
+	explicit flat_map(simple_vector<value_type> items, Compare comp = {})
+		: comp_(std::move(comp))
+	{
+		detail::sort_unique_last(items, key_of_, comp_);
+		keys_.reserve(items.size());
+		values_.reserve(items.size());
+		for (value_type& item : items)
+		{
+			keys_.push_back(std::move(item.first));
+			values_.push_back(std::move(item.second));
+		}
+	}
+
+	flat_map(std::initializer_list<value_type> init)
+		: flat_map(simple_vector<value_type>(init))
+	{
+	}
+
+	size_t size() const noexcept { return keys_.size(); }
+
+	bool empty() const noexcept { return keys_.empty(); }
+
+	void reserve(size_t capacity)
+	{
+		keys_.reserve(capacity);
+		values_.reserve(capacity);
+	}
+
+	void clear() noexcept
+	{
+		keys_.clear();
+		values_.clear();
+	}
+
+	iterator begin() noexcept { return iterator(this, 0); }
+
+	iterator end() noexcept { return iterator(this, size()); }
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, size());
+	}
+
+	std::span<const K> keys() const noexcept
+	{
+		return {keys_.data(), keys_.size()};
+	}
+
+	std::span<V> values() noexcept { return {values_.data(), values_.size()}; }
+
+	std::span<const V> values() const noexcept
+	{
+		return {values_.data(), values_.size()};
+	}
+
+	V* find(const K& key)
+	{
+		const size_t i = index_of_(key);
+		return found_(i, key) ? &values_[i] : nullptr;
+	}
+
+	const V* find(const K& key) const
+	{
+		const size_t i = index_of_(key);
+		return found_(i, key) ? &values_[i] : nullptr;
+	}
+
+	bool contains(const K& key) const { return found_(index_of_(key), key); }
+
+	iterator lower_bound(const K& key)
+	{
+		return iterator(this, index_of_(key));
+	}
+
+	const_iterator lower_bound(const K& key) const
+	{
+		return const_iterator(this, index_of_(key));
+	}
+
+	V& at(const K& key)
+	{
+		V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	const V& at(const K& key) const
+	{
+		const V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	V& operator[](const K& key)
+	{
+		const size_t i = index_of_(key);
+		if (!found_(i, key))
+		{
+			insert_at_(i, key, V());
+		}
+		return values_[i];
+	}
+
+	// true, если ключа ещё не было; иначе значение перезаписывается.
+	bool insert(const K& key, const V& value)
+	{
+		const size_t i = index_of_(key);
+		if (found_(i, key))
+		{
+			values_[i] = value;
+			return false;
+		}
+		insert_at_(i, key, value);
+		return true;
+	}
+
+	bool insert(const value_type& item)
+	{
+		return insert(item.first, item.second);
+	}
+
+	// Вливает пачку за один проход: O(size() + m log m). Значения из пачки
+	// перезаписывают существующие.
+	void insert(simple_vector<value_type> batch)
+	{
+		detail::sort_unique_last(batch, key_of_, comp_);
+		simple_vector<K> keys;
+		simple_vector<V> values;
+		keys.reserve(keys_.size() + batch.size());
+		values.reserve(keys_.size() + batch.size());
+		size_t i = 0;
+		size_t j = 0;
+		while (i < keys_.size() || j < batch.size())
+		{
+			const bool take_old =
+				j == batch.size() ||
+				(i < keys_.size() && comp_(keys_[i], batch[j].first));
+			if (take_old)
+			{
+				keys.push_back(std::move(keys_[i]));
+				values.push_back(std::move(values_[i]));
+				++i;
+				continue;
+			}
+			if (i < keys_.size() && !comp_(batch[j].first, keys_[i]))
+			{
+				++i;
+			}
+			keys.push_back(std::move(batch[j].first));
+			values.push_back(std::move(batch[j].second));
+			++j;
+		}
+		keys_.swap(keys);
+		values_.swap(values);
+	}
+
+	bool erase(const K& key)
+	{
+		const size_t i = index_of_(key);
+		if (!found_(i, key))
+		{
+			return false;
+		}
+		keys_.erase(keys_.cbegin() + i);
+		values_.erase(values_.cbegin() + i);
+		return true;
+	}
+
+   private:
+	static const K& key_of_(const value_type& item) { return item.first; }
+
+	size_t index_of_(const K& key) const
+	{
+		return detail::branchless_lower_bound(keys_.data(), keys_.size(), key,
+											  comp_);
+	}
+
+	bool found_(size_t i, const K& key) const
+	{
+		return i < keys_.size() && !comp_(key, keys_[i]);
+	}
+
+	// Если вставка значения бросает, ключ убирается: колонки ключей и
+	// значений должны совпадать по длине.
+	void insert_at_(size_t i, const K& key, const V& value)
+	{
+		keys_.insert(keys_.cbegin() + i, key);
+		try
+		{
+			values_.insert(values_.cbegin() + i, value);
+		}
+		catch (...)
+		{
+			keys_.erase(keys_.cbegin() + i);
+			throw;
+		}
+	}
+
+	simple_vector<K> keys_;
+	simple_vector<V> values_;
+	[[no_unique_address]] Compare comp_;
+};
+}  // namespace bmstu
@@ -0,0 +1,245 @@
+#include "flat_map.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "bmstu_map.h"
+
+TEST(FlatSet, BulkConstructionSortsAndDeduplicates)
+{
+	bmstu::flat_set<int> set{5, 1, 4, 1, 5, 9, 2, 6};
+	ASSERT_EQ(set.size(), 6u);
+	ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+			  (std::vector<int>{1, 2, 4, 5, 6, 9}));
+	ASSERT_TRUE(set.contains(9));
+	ASSERT_FALSE(set.contains(3));
+	ASSERT_EQ(set.count(4), 1u);
+	ASSERT_EQ(*set.lower_bound(3), 4);
+	ASSERT_EQ(set.lower_bound(10), set.end());
+	ASSERT_EQ(set.find(7), set.end());
+}
+
+TEST(FlatSet, InsertAndErase)
+{
+	bmstu::flat_set<std::string> set;
+	ASSERT_TRUE(set.insert("b"));
+	ASSERT_TRUE(set.insert("a"));
+	ASSERT_FALSE(set.insert("b"));
+	ASSERT_TRUE(set.insert("c"));
+	ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()),
+			  (std::vector<std::string>{"a", "b", "c"}));
+	ASSERT_TRUE(set.erase("b"));
+	ASSERT_FALSE(set.erase("b"));
+	ASSERT_EQ(set.size(), 2u);
+}
+
+TEST(FlatSet, BatchInsertMerges)
+{
+	bmstu::flat_set<int> set{1, 3, 5, 7};
+	set.insert(bmstu::simple_vector<int>{8, 0, 3, 4, 4});
+	ASSERT_EQ(set, (bmstu::flat_set<int>{0, 1, 3, 4, 5, 7, 8}));
+	set.insert(bmstu::simple_vector<int>{});
+	ASSERT_EQ(set.size(), 7u);
+}
+
+TEST(FlatSet, CustomComparator)
+{
+	bmstu::flat_set<int, std::greater<int>> set{1, 3, 2};
+	ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+			  (std::vector<int>{3, 2, 1}));
+	ASSERT_TRUE(set.contains(2));
+}
+
+TEST(FlatMap, BasicAccess)
+{
+	bmstu::flat_map<std::string, int> map;
+	map["banana"] = 2;
+	map["apple"] = 1;
+	ASSERT_TRUE(map.insert("cherry", 3));
+	ASSERT_FALSE(map.insert("apple", 10));
+	ASSERT_EQ(map.size(), 3u);
+	ASSERT_EQ(map.at("apple"), 10);
+	ASSERT_EQ(*map.find("banana"), 2);
+	ASSERT_EQ(map.find("grape"), nullptr);
+	ASSERT_THROW(map.at("grape"), std::out_of_range);
+	ASSERT_EQ(std::vector<std::string>(map.keys().begin(), map.keys().end()),
+			  (std::vector<std::string>{"apple", "banana", "cherry"}));
+	ASSERT_TRUE(map.erase("banana"));
+	ASSERT_FALSE(map.contains("banana"));
+	ASSERT_EQ(map.values()[1], 3);
+}
+
+TEST(FlatMap, BulkConstructionLastWins)
+{
+	bmstu::flat_map<int, std::string> map{
+		{3, "c"}, {1, "a"}, {2, "b"}, {1, "A"}};
+	ASSERT_EQ(map.size(), 3u);
+	ASSERT_EQ(map.at(1), "A");
+	std::vector<int> keys;
+	for (const auto& [key, value] : map)
+	{
+		keys.push_back(key);
+	}
+	ASSERT_EQ(keys, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(FlatMap, BatchInsertMerges)
+{
+	bmstu::flat_map<int, int> map{{1, 10}, {3, 30}, {5, 50}};
+	map.insert(bmstu::simple_vector<std::pair<int, int>>{
+		{4, 40}, {3, 33}, {0, 0}, {4, 44}});
+	ASSERT_EQ(map.size(), 5u);
+	ASSERT_EQ(std::vector<int>(map.keys().begin(), map.keys().end()),
+			  (std::vector<int>{0, 1, 3, 4, 5}));
+	ASSERT_EQ(std::vector<int>(map.values().begin(), map.values().end()),
+			  (std::vector<int>{0, 10, 33, 44, 50}));
+}
+
+TEST(FlatMap, IteratorWritesValues)
+{
+	bmstu::flat_map<int, int> map{{1, 1}, {2, 2}};
+	for (auto [key, value] : map)
+	{
+		value *= 10;
+	}
+	ASSERT_EQ(map.at(2), 20);
+	auto it = map.lower_bound(2);
+	ASSERT_EQ(it->first, 2);
+	ASSERT_EQ(it->second, 20);
+	bmstu::flat_map<int, int>::const_iterator cit = it;
+	ASSERT_EQ(cit - map.begin(), 1);
+}
+
+TEST(FlatMap, MatchesStdMap)
+{
+	std::mt19937 gen(3);
+	std::map<int, int> expected;
+	bmstu::flat_map<int, int> map;
+	for (int i = 0; i < 5000; ++i)
+	{
+		const int key = static_cast<int>(gen() % 2000);
+		if (gen() % 4 == 0)
+		{
+			ASSERT_EQ(map.erase(key), expected.erase(key) == 1);
+		}
+		else
+		{
+			map[key] = i;
+			expected[key] = i;
+		}
+	}
+	ASSERT_EQ(map.size(), expected.size());
+	auto it = expected.begin();
+	for (const auto& [key, value] : map)
+	{
+		ASSERT_EQ(key, it->first);
+		ASSERT_EQ(value, it->second);
+		++it;
+	}
+}
+
+namespace
+{
+struct fragile_value
+{
+	static inline bool fail = false;
+
+	fragile_value() = default;
+
+	explicit fragile_value(int v) : value(v) {}
+
+	fragile_value(const fragile_value& other) : value(other.value)
+	{
+		if (fail)
+		{
+			throw std::runtime_error("copy failed");
+		}
+	}
+
+	fragile_value& operator=(const fragile_value& other) = default;
+
+	int value = 0;
+};
+}  // namespace
+
+TEST(FlatMap, FailedInsertKeepsKeysAndValuesAligned)
+{
+	bmstu::flat_map<int, fragile_value> map;
+	map.insert(1, fragile_value(10));
+	map.insert(3, fragile_value(30));
+	fragile_value::fail = true;
+	ASSERT_THROW(map.insert(2, fragile_value(20)), std::runtime_error);
+	fragile_value::fail = false;
+	ASSERT_EQ(map.size(), 2u);
+	ASSERT_FALSE(map.contains(2));
+	ASSERT_EQ(map.at(3).value, 30);
+	map.insert(2, fragile_value(20));
+	ASSERT_EQ(map.at(2).value, 20);
+	ASSERT_EQ(map.at(3).value, 30);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(FlatMapBench, DISABLED_LookupVsAvlMap)
+{
+	constexpr size_t kLookups = 10'000'000;
+	for (size_t size : {1'000u, 100'000u, 1'000'000u})
+	{
+		std::mt19937_64 gen(size);
+		bmstu::simple_vector<std::pair<int64_t, int64_t>> items;
+		bmstu::map<int64_t, int64_t> avl;
+		std::map<int64_t, int64_t> reference;
+		for (size_t i = 0; i < size; ++i)
+		{
+			const auto key = static_cast<int64_t>(gen() >> 1);
+			items.push_back({key, key});
+			avl.insert(key, key);
+			reference.emplace(key, key);
+		}
+		bmstu::flat_map<int64_t, int64_t> flat(items);
+		bmstu::simple_vector<int64_t> probes(kLookups);
+		for (int64_t& probe : probes)
+		{
+			probe = items[gen() % size].first;
+		}
+
+		int64_t flat_sum = 0;
+		int64_t avl_sum = 0;
+		int64_t std_sum = 0;
+		const double flat_ms = measure_ms(
+			[&]
+			{
+				for (int64_t probe : probes)
+				{
+					flat_sum += *flat.find(probe);
+				}
+			});
+		const double avl_ms = measure_ms(
+			[&]
+			{
+				for (int64_t probe : probes)
+				{
+					avl_sum += *avl.find(probe);
+				}
+			});
+		const double std_ms = measure_ms(
+			[&]
+			{
+				for (int64_t probe : probes)
+				{
+					std_sum += reference.find(probe)->second;
+				}
+			});
+		ASSERT_EQ(flat_sum, avl_sum);
+		ASSERT_EQ(flat_sum, std_sum);
+		std::cout << size << " keys: flat_map " << kLookups / flat_ms / 1e3
+				  << " M/s, bmstu::map " << kLookups / avl_ms / 1e3
+				  << " M/s, std::map " << kLookups / std_ms / 1e3 << " M/s\n";
+	}
+}
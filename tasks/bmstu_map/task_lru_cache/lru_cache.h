@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "bmstu_list.h"
+#include "bmstu_map.h"
+
+namespace bmstu
+{
+// Кэш с вытеснением давно не использованных элементов. Элементы лежат в
+// bmstu::list в порядке обращений: в голове самый свежий, в хвосте —
+// кандидат на вытеснение. Индекс bmstu::map хранит для ключа итератор на
+// его узел, поэтому попадание переносит узел в голову одним splice, без
+// копирования значения и без выделения памяти.
+template <typename K, typename V>
+class lru_cache
+{
+   public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<const K, V>;
+	// Вызывается для вытесняемого элемента до его удаления; значение можно
+	// забрать из него перемещением.
+	using eviction_callback = std::function<void(const K&, V&)>;
+
+	explicit lru_cache(size_t capacity, eviction_callback on_evict = {})
+		: capacity_(capacity), on_evict_(std::move(on_evict))
+	{
+		if (capacity_ == 0)
+		{
+			throw std::invalid_argument("lru_cache capacity must be positive");
+		}
+	}
+
+	lru_cache(const lru_cache& other) = delete;
+	lru_cache& operator=(const lru_cache& other) = delete;
+
+	// Значение по ключу или nullptr; попадание делает элемент самым свежим.
+	// Указатель действителен до следующего изменения кэша.
+	V* get(const K& key)
+	{
+		iterator* where = index_.find(key);
+		if (where == nullptr)
+		{
+			++misses_;
+			return nullptr;
+		}
+		++hits_;
+		touch_(*where);
+		return &(*where)->second;
+	}
+
+	// Вставляет или обновляет значение; при переполнении вытесняет самый
+	// давний элемент.
+	void put(const K& key, V value)
+	{
+		if (iterator* where = index_.find(key))
+		{
+			(*where)->second = std::move(value);
+			touch_(*where);
+			return;
+		}
+		if (order_.size() == capacity_)
+		{
+			evict_();
+		}
+		order_.emplace_front(key, std::move(value));
+		try
+		{
+			index_.insert(key, order_.begin());
+		}
+		catch (...)
+		{
+			order_.pop_front();
+			throw;
+		}
+	}
+
+	bool erase(const K& key)
+	{
+		iterator* where = index_.find(key);
+		if (where == nullptr)
+		{
+			return false;
+		}
+		const iterator it = *where;
+		index_.erase(key);
+		order_.erase(it);
+		return true;
+	}
+
+	// Не меняет ни порядок, ни счётчики.
+	bool contains(const K& key) const { return index_.contains(key); }
+
+	void clear()
+	{
+		index_.clear();
+		order_.clear();
+	}
+
+	size_t size() const noexcept { return order_.size(); }
+
+	bool empty() const noexcept { return order_.empty(); }
+
+	size_t capacity() const noexcept { return capacity_; }
+
+	size_t hits() const noexcept { return hits_; }
+
+	size_t misses() const noexcept { return misses_; }
+
+	void reset_stats() noexcept
+	{
+		hits_ = 0;
+		misses_ = 0;
+	}
+
+	// Обход от самого свежего элемента к самому давнему.
+	typename list<value_type>::const_iterator begin() const noexcept
+	{
+		return order_.begin();
+	}
+
+	typename list<value_type>::const_iterator end() const noexcept
+	{
+		return order_.end();
+	}
+
+   private:
+	using iterator = typename list<value_type>::iterator;
+
+	void touch_(iterator it) { order_.splice(order_.cbegin(), order_, it); }
+
+	void evict_()
+	{
+		value_type& victim = order_.back();
+		if (on_evict_)
+		{
+			on_evict_(victim.first, victim.second);
+		}
+		index_.erase(victim.first);
+		order_.pop_back();
+	}
+
+	size_t capacity_;
+	size_t hits_ = 0;
+	size_t misses_ = 0;
+	eviction_callback on_evict_;
+	list<value_type> order_;
+	map<K, iterator> index_;
+};
+
+// Потокобезопасный вариант: ключи раскладываются хешем по независимым
+// шардам, у каждого свой lru_cache и свой мьютекс, поэтому потоки,
+// попавшие в разные шарды, не ждут друг друга. Порядок вытеснения
+// соблюдается внутри шарда, а не во всём кэше. Обработчик вытеснения
+// вызывается под мьютексом шарда и не должен обращаться к кэшу.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class sharded_lru_cache
+{
+   public:
+	using key_type = K;
+	using mapped_type = V;
+	using eviction_callback = typename lru_cache<K, V>::eviction_callback;
+
+	// capacity делится между шардами поровну с округлением вверх.
+	sharded_lru_cache(size_t capacity,
+					  size_t shard_count,
+					  eviction_callback on_evict = {})
+	{
+		if (shard_count == 0)
+		{
+			throw std::invalid_argument("shard_count must be positive");
+		}
+		const size_t per_shard = (capacity + shard_count - 1) / shard_count;
+		shards_.reserve(shard_count);
+		for (size_t i = 0; i < shard_count; ++i)
+		{
+			shards_.push_back(std::make_unique<shard>(per_shard, on_evict));
+		}
+	}
+
+	// Копирует найденное значение в value: указатель внутрь шарда
+	// перестал бы быть действительным сразу после снятия блокировки.
+	bool get(const K& key, V& value)
+	{
+		shard& s = shard_for_(key);
+		std::lock_guard lock(s.mutex);
+		const V* found = s.cache.get(key);
+		if (found == nullptr)
+		{
+			return false;
+		}
+		value = *found;
+		return true;
+	}
+
+	void put(const K& key, V value)
+	{
+		shard& s = shard_for_(key);
+		std::lock_guard lock(s.mutex);
+		s.cache.put(key, std::move(value));
+	}
+
+	bool erase(const K& key)
+	{
+		shard& s = shard_for_(key);
+		std::lock_guard lock(s.mutex);
+		return s.cache.erase(key);
+	}
+
+	void clear()
+	{
+		for (auto& s : shards_)
+		{
+			std::lock_guard lock(s->mutex);
+			s->cache.clear();
+		}
+	}
+
+	// Сумма по шардам; при параллельной работе — приблизительный снимок.
+	size_t size() const { return sum_(&lru_cache<K, V>::size); }
+
+	size_t capacity() const
+	{
+		return shards_.front()->cache.capacity() * shards_.size();
+	}
+
+	size_t hits() const { return sum_(&lru_cache<K, V>::hits); }
+
+	size_t misses() const { return sum_(&lru_cache<K, V>::misses); }
+
+	size_t shard_count() const noexcept { return shards_.size(); }
+
+   private:
+	struct alignas(64) shard
+	{
+		shard(size_t capacity, const eviction_callback& on_evict)
+			: cache(capacity, on_evict)
+		{
+		}
+
+		mutable std::mutex mutex;
+		lru_cache<K, V> cache;
+	};
+
+	shard& shard_for_(const K& key)
+	{
+		return *shards_[hash_(key) % shards_.size()];
+	}
+
+	size_t sum_(size_t (lru_cache<K, V>::*counter)() const noexcept) const
+	{
+		size_t total = 0;
+		for (const auto& s : shards_)
+		{
+			std::lock_guard lock(s->mutex);
+			total += (s->cache.*counter)();
+		}
+		return total;
+	}
+
+	Hash hash_;
+	std::vector<std::unique_ptr<shard>> shards_;
+};
+}  // namespace bmstu
@@ -0,0 +1,298 @@
+#include "lru_cache.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bench.h"
+
+namespace
+{
+template <typename K, typename V>
+std::vector<K> keys(const bmstu::lru_cache<K, V>& cache)
+{
+	std::vector<K> result;
+	for (const auto& entry : cache)
+	{
+		result.push_back(entry.first);
+	}
+	return result;
+}
+}  // namespace
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+	bmstu::lru_cache<int, std::string> cache(3);
+	ASSERT_TRUE(cache.empty());
+	ASSERT_EQ(cache.capacity(), 3u);
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.put(3, "three");
+	ASSERT_EQ(keys(cache), (std::vector<int>{3, 2, 1}));
+
+	ASSERT_EQ(*cache.get(1), "one");
+	ASSERT_EQ(keys(cache), (std::vector<int>{1, 3, 2}));
+	cache.put(4, "four");
+	ASSERT_EQ(cache.size(), 3u);
+	ASSERT_FALSE(cache.contains(2));
+	ASSERT_EQ(cache.get(2), nullptr);
+	ASSERT_EQ(keys(cache), (std::vector<int>{4, 1, 3}));
+}
+
+TEST(LruCacheTest, PutUpdatesAndRefreshes)
+{
+	bmstu::lru_cache<int, int> cache(2);
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(1, 11);
+	ASSERT_EQ(cache.size(), 2u);
+	ASSERT_EQ(keys(cache), (std::vector<int>{1, 2}));
+	cache.put(3, 30);
+	ASSERT_TRUE(cache.contains(1));
+	ASSERT_FALSE(cache.contains(2));
+	ASSERT_EQ(*cache.get(1), 11);
+	*cache.get(3) = 31;
+	ASSERT_EQ(*cache.get(3), 31);
+}
+
+TEST(LruCacheTest, EvictionCallback)
+{
+	std::vector<std::pair<int, std::unique_ptr<int>>> evicted;
+	bmstu::lru_cache<int, std::unique_ptr<int>> cache(
+		2,
+		[&evicted](const int& key, std::unique_ptr<int>& value)
+		{ evicted.emplace_back(key, std::move(value)); });
+	cache.put(1, std::make_unique<int>(100));
+	cache.put(2, std::make_unique<int>(200));
+	cache.get(1);
+	cache.put(3, std::make_unique<int>(300));
+	cache.put(4, std::make_unique<int>(400));
+	ASSERT_EQ(evicted.size(), 2u);
+	ASSERT_EQ(evicted[0].first, 2);
+	ASSERT_EQ(*evicted[0].second, 200);
+	ASSERT_EQ(evicted[1].first, 1);
+	ASSERT_EQ(*evicted[1].second, 100);
+
+	// Явное удаление и очистка обработчик не вызывают.
+	ASSERT_TRUE(cache.erase(3));
+	ASSERT_FALSE(cache.erase(3));
+	cache.clear();
+	ASSERT_TRUE(cache.empty());
+	ASSERT_EQ(evicted.size(), 2u);
+	cache.put(5, std::make_unique<int>(500));
+	ASSERT_EQ(**cache.get(5), 500);
+}
+
+TEST(LruCacheTest, HitMissCounters)
+{
+	bmstu::lru_cache<int, int> cache(2);
+	cache.put(1, 1);
+	cache.get(1);
+	cache.get(1);
+	cache.get(2);
+	ASSERT_TRUE(cache.contains(1));
+	ASSERT_EQ(cache.hits(), 2u);
+	ASSERT_EQ(cache.misses(), 1u);
+	cache.reset_stats();
+	ASSERT_EQ(cache.hits(), 0u);
+	ASSERT_EQ(cache.misses(), 0u);
+	ASSERT_THROW((bmstu::lru_cache<int, int>(0)), std::invalid_argument);
+}
+
+TEST(LruCacheTest, ShardedConcurrentAccess)
+{
+	constexpr int kThreads = 4;
+	constexpr int kOps = 50'000;
+	bmstu::sharded_lru_cache<int, int64_t> cache(256, 8);
+	ASSERT_EQ(cache.shard_count(), 8u);
+	ASSERT_EQ(cache.capacity(), 256u);
+
+	std::vector<std::thread> threads;
+	std::vector<int> wrong(kThreads, 0);
+	for (int t = 0; t < kThreads; ++t)
+	{
+		threads.emplace_back(
+			[&, t]
+			{
+				std::mt19937 gen(t);
+				for (int i = 0; i < kOps; ++i)
+				{
+					const int key = static_cast<int>(gen() % 1024);
+					int64_t value = 0;
+					if (cache.get(key, value))
+					{
+						wrong[t] += value != int64_t{key} * 7;
+					}
+					else
+					{
+						cache.put(key, int64_t{key} * 7);
+					}
+				}
+			});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+	for (int count : wrong)
+	{
+		ASSERT_EQ(count, 0);
+	}
+	ASSERT_LE(cache.size(), cache.capacity());
+	ASSERT_EQ(cache.hits() + cache.misses(), size_t{kThreads} * kOps);
+	cache.put(5, 35);
+	ASSERT_TRUE(cache.erase(5));
+	cache.clear();
+	ASSERT_EQ(cache.size(), 0u);
+}
+
+namespace
+{
+using bmstu::bench::measure_ms;
+
+// Ключи с вероятностью, обратной рангу в степени s (закон Ципфа).
+std::vector<int64_t> zipf_trace(size_t keys, size_t length, double s)
+{
+	std::vector<double> weights(keys);
+	for (size_t i = 0; i < keys; ++i)
+	{
+		weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), s);
+	}
+	std::discrete_distribution<int64_t> dist(weights.begin(), weights.end());
+	std::mt19937_64 gen(17);
+	// Ранг перемешивается, чтобы горячие ключи не шли подряд.
+	std::vector<int64_t> ids(keys);
+	for (size_t i = 0; i < keys; ++i)
+	{
+		ids[i] = static_cast<int64_t>(i);
+	}
+	std::shuffle(ids.begin(), ids.end(), gen);
+	std::vector<int64_t> trace(length);
+	for (int64_t& key : trace)
+	{
+		key = ids[dist(gen)];
+	}
+	return trace;
+}
+
+// Кэш, который собирают вручную: std::list и std::unordered_map.
+class std_lru_cache
+{
+   public:
+	explicit std_lru_cache(size_t capacity) : capacity_(capacity) {}
+
+	int64_t* get(int64_t key)
+	{
+		auto found = index_.find(key);
+		if (found == index_.end())
+		{
+			return nullptr;
+		}
+		order_.splice(order_.begin(), order_, found->second);
+		return &found->second->second;
+	}
+
+	void put(int64_t key, int64_t value)
+	{
+		if (order_.size() == capacity_)
+		{
+			index_.erase(order_.back().first);
+			order_.pop_back();
+		}
+		order_.emplace_front(key, value);
+		index_.emplace(key, order_.begin());
+	}
+
+   private:
+	using entry = std::pair<int64_t, int64_t>;
+
+	size_t capacity_;
+	std::list<entry> order_;
+	std::unordered_map<int64_t, std::list<entry>::iterator> index_;
+};
+}  // namespace
+
+TEST(LruCacheBench, DISABLED_ZipfTrace)
+{
+	constexpr size_t kKeys = 1'000'000;
+	constexpr size_t kOps = 5'000'000;
+	const std::vector<int64_t> trace = zipf_trace(kKeys, kOps, 0.99);
+	std::cout << "zipf s=0.99, " << kKeys << " keys, ns/op (hit rate):\n";
+	for (size_t capacity : {1'000u, 10'000u, 100'000u})
+	{
+		bmstu::lru_cache<int64_t, int64_t> cache(capacity);
+		const double cache_ms = measure_ms(
+			[&]
+			{
+				for (int64_t key : trace)
+				{
+					if (cache.get(key) == nullptr)
+					{
+						cache.put(key, key);
+					}
+				}
+			});
+
+		std_lru_cache reference(capacity);
+		size_t reference_hits = 0;
+		const double reference_ms = measure_ms(
+			[&]
+			{
+				for (int64_t key : trace)
+				{
+					if (reference.get(key) != nullptr)
+					{
+						++reference_hits;
+					}
+					else
+					{
+						reference.put(key, key);
+					}
+				}
+			});
+		ASSERT_EQ(cache.hits(), reference_hits);
+
+		bmstu::sharded_lru_cache<int64_t, int64_t> sharded(capacity, 16);
+		const double sharded_ms = measure_ms(
+			[&]
+			{
+				std::vector<std::thread> threads;
+				for (size_t t = 0; t < 4; ++t)
+				{
+					threads.emplace_back(
+						[&, t]
+						{
+							int64_t value;
+							for (size_t i = t; i < kOps; i += 4)
+							{
+								if (!sharded.get(trace[i], value))
+								{
+									sharded.put(trace[i], trace[i]);
+								}
+							}
+						});
+				}
+				for (auto& t : threads)
+				{
+					t.join();
+				}
+			});
+
+		const double hit_rate = 100.0 * cache.hits() / kOps;
+		const double sharded_rate = 100.0 * sharded.hits() / kOps;
+		std::cout << "capacity " << capacity << ": lru_cache "
+				  << cache_ms * 1e6 / kOps << " (" << hit_rate
+				  << "%), std::list+unordered_map " << reference_ms * 1e6 / kOps
+				  << ", sharded x16 on 4 threads " << sharded_ms * 1e6 / kOps
+				  << " (" << sharded_rate << "%)\n";
+	}
+}
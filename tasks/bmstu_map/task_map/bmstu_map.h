@@ -18,8 +18,8 @@
  * 2. Iterator (map::iterator):
  *    - Конструктор для инициализации (найти самый левый узел для begin)
  *    - operator*() - разыменование (вернуть std::pair<const K, V>)
- *    - operator++() - переход к следующему элементу в in-order обходе
- *    - Использовать std::stack для обхода дерева
+ *    - operator++() / operator--() - соседний элемент в in-order обходе
+ *    - Обход идёт по ссылкам parent в узлах, без стека и выделений памяти
  *
  * 3. Map (map):
  *    - Все публичные методы уже реализованы и используют AVL дерево
@@ -32,34 +32,49 @@
  *
  * Тестирование:
  * - Запустите тесты: ./tasks/bmstu_map/bmstu_map
- * - Все 18 тестов должны пройти успешно после полной реализации
+ * - Все 37 тестов должны пройти успешно: 22 MapTest из bmstu_map_test.cpp
+ *   и собранные в тот же бинарник тесты flat_map (10) и lru_cache (5)
+ * - Бенчмарки (DISABLED_) запускаются с --gtest_also_run_disabled_tests
  */
 
+#pragma once
+
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <iterator>
-#include <stack>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
-#include "abstract_iterator.h"
+#include "node_pool.h"
 
 namespace bmstu
 {
 // ==================== AVL Tree Node ====================
+// Пара хранится в узле целиком, чтобы итератор map отдавал ссылку прямо
+// на неё. parent позволяет итератору ходить по дереву без стека. Ссылки и
+// высота лежат в начале узла, рядом друг с другом.
 template <typename K, typename V>
 struct tree_node
 {
 	tree_node(const K& k, const V& v)
-		: key(k), value(v), left(nullptr), right(nullptr), height(1)
+		: left(nullptr), right(nullptr), parent(nullptr), height(1), data(k, v)
 	{
 	}
 
-	K key;
-	V value;
-	uint8_t height;
+	const K& key() const noexcept { return data.first; }
+
+	V& value() noexcept { return data.second; }
+
+	const V& value() const noexcept { return data.second; }
+
 	tree_node* left;
 	tree_node* right;
+	tree_node* parent;
+	uint8_t height;
+	std::pair<const K, V> data;
 };
 
 // ==================== AVL Balanced Tree ====================
@@ -72,20 +87,195 @@ class avl_balanced_tree
 {
    public:
 	avl_balanced_tree() : root_(nullptr), size_(0) {}
-	~avl_balanced_tree() { clear(root_); }
+	~avl_balanced_tree() { clear(); }
 
-	void insert(const K& key, const V& value)
+	// Если ключ и значение не требуют деструкторов, узлы не обходятся:
+	// слэбы пула возвращаются системе за O(число слэбов).
+	void clear() noexcept
 	{
-		this->insert(key, value, root_);
+		if constexpr (!std::is_trivially_destructible_v<K> ||
+					  !std::is_trivially_destructible_v<V>)
+		{
+			destroy_subtree_(root_);
+		}
+		pool_.release();
+		root_ = nullptr;
+		size_ = 0;
 	}
 
-	void remove(const K& key) { this->remove(key, root_); }
+	// Узлы берутся из слэбов пула; удалённые переиспользуются.
+	const node_pool<tree_node<K, V>>& get_pool() const noexcept
+	{
+		return pool_;
+	}
 
-	tree_node<K, V>* find(const K& key) { return this->find(key, root_); }
+	// Вставка и удаление идут без рекурсии: путь от корня складывается в
+	// стек ссылок на указатели (&root_, &parent->left, ...) фиксированного
+	// размера, а балансировка поднимается по нему, пока высота поддерева
+	// меняется. Возвращает узел с ключом key.
+	tree_node<K, V>* insert(const K& key, const V& value)
+	{
+		tree_node<K, V>** path[kMaxDepth];
+		size_t depth = 0;
+		tree_node<K, V>** link = &root_;
+		tree_node<K, V>* parent = nullptr;
+		while (*link != nullptr)
+		{
+			tree_node<K, V>* node = *link;
+			parent = node;
+			if (key < node->key())
+			{
+				path[depth++] = link;
+				link = &node->left;
+			}
+			else if (node->key() < key)
+			{
+				path[depth++] = link;
+				link = &node->right;
+			}
+			else
+			{
+				node->value() = value;
+				return node;
+			}
+		}
+		tree_node<K, V>* inserted = create_node_(key, value);
+		inserted->parent = parent;
+		*link = inserted;
+		++size_;
+		rebalance_path_(path, depth);
+		return inserted;
+	}
+
+	void remove(const K& key)
+	{
+		tree_node<K, V>** path[kMaxDepth];
+		size_t depth = 0;
+		tree_node<K, V>** link = &root_;
+		while (*link != nullptr &&
+			   ((*link)->key() < key || key < (*link)->key()))
+		{
+			path[depth++] = link;
+			link = key < (*link)->key() ? &(*link)->left : &(*link)->right;
+		}
+		tree_node<K, V>* target = *link;
+		if (target == nullptr)
+		{
+			return;
+		}
+		if (target->left != nullptr && target->right != nullptr)
+		{
+			// Два ребёнка: на место узла встаёт минимум правого поддерева.
+			// Узлы переставляются целиком, ключи и значения не копируются.
+			const size_t target_depth = depth;
+			path[depth++] = link;
+			tree_node<K, V>** min_link = &target->right;
+			while ((*min_link)->left != nullptr)
+			{
+				path[depth++] = min_link;
+				min_link = &(*min_link)->left;
+			}
+			tree_node<K, V>* min = *min_link;
+			*min_link = min->right;
+			if (min->right != nullptr)
+			{
+				min->right->parent = min->parent;
+			}
+			min->left = target->left;
+			min->right = target->right;
+			min->left->parent = min;
+			if (min->right != nullptr)
+			{
+				min->right->parent = min;
+			}
+			min->parent = target->parent;
+			min->height = target->height;
+			*link = min;
+			if (target_depth + 1 < depth)
+			{
+				// Эта ссылка указывала внутрь удаляемого узла.
+				path[target_depth + 1] = &min->right;
+			}
+		}
+		else
+		{
+			tree_node<K, V>* child =
+				target->left != nullptr ? target->left : target->right;
+			if (child != nullptr)
+			{
+				child->parent = target->parent;
+			}
+			*link = child;
+		}
+		destroy_node_(target);
+		--size_;
+		rebalance_path_(path, depth);
+	}
+
+	tree_node<K, V>* find(const K& key)
+	{
+		return const_cast<tree_node<K, V>*>(std::as_const(*this).find(key));
+	}
 
 	const tree_node<K, V>* find(const K& key) const
 	{
-		return this->find(key, root_);
+		const tree_node<K, V>* node = root_;
+		while (node != nullptr)
+		{
+			if (key < node->key())
+			{
+				node = node->left;
+			}
+			else if (node->key() < key)
+			{
+				node = node->right;
+			}
+			else
+			{
+				return node;
+			}
+		}
+		return nullptr;
+	}
+
+	// Первый узел с ключом не меньше key; nullptr, если такого нет.
+	const tree_node<K, V>* lower_bound(const K& key) const
+	{
+		const tree_node<K, V>* node = root_;
+		const tree_node<K, V>* result = nullptr;
+		while (node != nullptr)
+		{
+			if (node->key() < key)
+			{
+				node = node->right;
+			}
+			else
+			{
+				result = node;
+				node = node->left;
+			}
+		}
+		return result;
+	}
+
+	// Первый узел с ключом больше key; nullptr, если такого нет.
+	const tree_node<K, V>* upper_bound(const K& key) const
+	{
+		const tree_node<K, V>* node = root_;
+		const tree_node<K, V>* result = nullptr;
+		while (node != nullptr)
+		{
+			if (key < node->key())
+			{
+				result = node;
+				node = node->left;
+			}
+			else
+			{
+				node = node->right;
+			}
+		}
+		return result;
 	}
 
 	bool contains(const K& key) const { return find(key) != nullptr; }
@@ -107,87 +297,120 @@ class avl_balanced_tree
 	}
 
    private:
-	tree_node<K, V>* insert(const K& key,
-							const V& value,
-							tree_node<K, V>*& node)
-	{
-		// TODO: Реализовать вставку узла в AVL дерево
-		// 1. Если node == nullptr, создать новый узел
-		// 2. Рекурсивно вставить в левое или правое поддерево в зависимости от
-		// ключа
-		// 3. Обновить значение, если ключ уже существует
-		// 4. Вызвать balance(node) для балансировки
-		return nullptr;
-	}
+	// Высота AVL-дерева из n узлов не больше 1.44 * log2(n + 2), то есть
+	// меньше 93 при любом size_t.
+	static constexpr size_t kMaxDepth = 96;
 
-	void remove(const K& key, tree_node<K, V>*& node)
+	// Балансирует узлы пути снизу вверх. Если высота поддерева после
+	// балансировки осталась прежней, выше ничего не меняется.
+	void rebalance_path_(tree_node<K, V>** path[], size_t depth)
 	{
-		// TODO: Реализовать удаление узла из AVL дерева
-		// 1. Найти узел с заданным ключом
-		// 2. Обработать 4 случая:
-		//    - Узел без детей (лист)
-		//    - Узел с одним ребенком (левым или правым)
-		//    - Узел с двумя детьми (заменить на минимальный из правого
-		//    поддерева)
-		// 3. Декрементировать size_
-		// 4. Вызвать balance(node) для балансировки
+		while (depth > 0)
+		{
+			tree_node<K, V>*& node = *path[--depth];
+			const uint8_t before = node->height;
+			balance(node);
+			if (node->height == before)
+			{
+				break;
+			}
+		}
 	}
 
-	tree_node<K, V>* find(const K& key, tree_node<K, V>* node) const
+	tree_node<K, V>* findMinPtr(tree_node<K, V>* node)
 	{
-		// TODO: Реализовать поиск узла по ключу
-		// Рекурсивно искать в левом или правом поддереве
-		return nullptr;
+		while (node != nullptr && node->left != nullptr)
+		{
+			node = node->left;
+		}
+		return node;
 	}
 
-	tree_node<K, V>* findMinPtr(tree_node<K, V>* node)
+	// Высота хранится в узле и обновляется в balance() и поворотах.
+	uint8_t heightOfTree(tree_node<K, V>* t)
 	{
-		// TODO: Найти узел с минимальным ключом в поддереве
-		// Подсказка: идти влево, пока возможно
-		return nullptr;
+		return t == nullptr ? 0 : t->height;
 	}
 
-	uint8_t heightOfTree(tree_node<K, V>* t)
+	void updateHeight(tree_node<K, V>* t)
 	{
-		// TODO: Вычислить высоту дерева
-		// Высота пустого дерева = 0
-		// Высота дерева = 1 + max(высота левого, высота правого)
-		return 0;
+		t->height = std::max(heightOfTree(t->left), heightOfTree(t->right)) + 1;
 	}
 
 	void rotateWithLeftChild(tree_node<K, V>*& k2)
 	{
-		// TODO: Реализовать правый поворот (rotation with left child)
-		// Используется для балансировки Left-Left случая
+		tree_node<K, V>* k1 = k2->left;
+		k2->left = k1->right;
+		if (k2->left != nullptr)
+		{
+			k2->left->parent = k2;
+		}
+		k1->right = k2;
+		k1->parent = k2->parent;
+		k2->parent = k1;
+		updateHeight(k2);
+		updateHeight(k1);
+		k2 = k1;
 	}
 
 	void rotateWithRightChild(tree_node<K, V>*& k1)
 	{
-		// TODO: Реализовать левый поворот (rotation with right child)
-		// Используется для балансировки Right-Right случая
+		tree_node<K, V>* k2 = k1->right;
+		k1->right = k2->left;
+		if (k1->right != nullptr)
+		{
+			k1->right->parent = k1;
+		}
+		k2->left = k1;
+		k2->parent = k1->parent;
+		k1->parent = k2;
+		updateHeight(k1);
+		updateHeight(k2);
+		k1 = k2;
 	}
 
 	void doubleWithLeftChild(tree_node<K, V>*& k3)
 	{
-		// TODO: Реализовать двойной поворот Left-Right
-		// Сначала левый поворот на левом ребенке, затем правый поворот на узле
+		rotateWithRightChild(k3->left);
+		rotateWithLeftChild(k3);
 	}
 
 	void doubleWithRightChild(tree_node<K, V>*& k1)
 	{
-		// TODO: Реализовать двойной поворот Right-Left
-		// Сначала правый поворот на правом ребенке, затем левый поворот на узле
+		rotateWithLeftChild(k1->right);
+		rotateWithRightChild(k1);
 	}
 
 	void balance(tree_node<K, V>*& t)
 	{
-		// TODO: Реализовать балансировку AVL дерева
-		// 1. Вычислить разность высот левого и правого поддеревьев
-		// 2. Если разность > 1, выполнить соответствующие повороты:
-		//    - Left-Left: rotateWithLeftChild
-		//    - Left-Right: doubleWithLeftChild
-		//    - Right-Right: rotateWithRightChild
-		//    - Right-Left: doubleWithRightChild
+		if (t == nullptr)
+		{
+			return;
+		}
+		const int diff = heightOfTree(t->left) - heightOfTree(t->right);
+		if (diff > 1)
+		{
+			if (heightOfTree(t->left->left) >= heightOfTree(t->left->right))
+			{
+				rotateWithLeftChild(t);
+			}
+			else
+			{
+				doubleWithLeftChild(t);
+			}
+		}
+		else if (diff < -1)
+		{
+			if (heightOfTree(t->right->right) >= heightOfTree(t->right->left))
+			{
+				rotateWithRightChild(t);
+			}
+			else
+			{
+				doubleWithRightChild(t);
+			}
+		}
+		updateHeight(t);
 	}
 
 	void inorder_print(tree_node<K, V>* node)
@@ -197,17 +420,39 @@ class avl_balanced_tree
 			return;
 		}
 		inorder_print(node->left);
-		std::cout << "[" << node->key << ":" << node->value << "] ";
+		std::cout << "[" << node->key() << ":" << node->value() << "] ";
 		inorder_print(node->right);
 	}
 
-	void clear(tree_node<K, V>* node)
+	tree_node<K, V>* create_node_(const K& key, const V& value)
+	{
+		tree_node<K, V>* node = pool_.allocate();
+		try
+		{
+			std::construct_at(node, key, value);
+		}
+		catch (...)
+		{
+			pool_.deallocate(node);
+			throw;
+		}
+		return node;
+	}
+
+	void destroy_node_(tree_node<K, V>* node) noexcept
+	{
+		std::destroy_at(node);
+		pool_.deallocate(node);
+	}
+
+	// Память узлов остаётся в пуле: clear() сразу отдаёт её целиком.
+	void destroy_subtree_(tree_node<K, V>* node) noexcept
 	{
 		if (node != nullptr)
 		{
-			clear(node->left);
-			clear(node->right);
-			delete node;
+			destroy_subtree_(node->left);
+			destroy_subtree_(node->right);
+			std::destroy_at(node);
 		}
 	}
 
@@ -223,10 +468,11 @@ class avl_balanced_tree
 		{
 			std::cout << " ";
 		}
-		std::cout << node->key << ":" << node->value << "\n";
+		std::cout << node->key() << ":" << node->value() << "\n";
 		this->print_tree_(node->left, space);
 	}
 
+	node_pool<tree_node<K, V>> pool_;
 	tree_node<K, V>* root_ = nullptr;
 	size_t size_ = 0;
 };
@@ -245,113 +491,194 @@ class map
 	using value_type = std::pair<const K, V>;
 
 	// ==================== Iterator ====================
-	// ЗАДАНИЕ ДЛЯ СТУДЕНТОВ:
-	// Реализуйте итератор для обхода элементов map в порядке возрастания ключей
-	// (in-order обход AVL дерева). Итератор должен поддерживать операции
-	// инкремента и разыменования.
-	struct iterator : public abstract_iterator<iterator,
-											   std::pair<const K, V>,
-											   std::bidirectional_iterator_tag>
+	// Итератор — два указателя: на узел и на дерево (чтобы --end() нашёл
+	// максимум). Переход к соседу идёт по ссылкам на родителя: без стека и
+	// выделений памяти, за O(1) в среднем на шаг. Разыменование отдаёт
+	// ссылку на пару в узле. В отличие от итераторов списков, он не
+	// наследует abstract_iterator: указатель на таблицу виртуальных функций
+	// сделал бы его тремя словами.
+	template <bool Const>
+	class basic_iterator
 	{
-		tree_node<K, V>* current_;
-		std::stack<tree_node<K, V>*> stack_;
-		mutable typename iterator::value_type pair_cache_;
-
-		iterator() : current_(nullptr), pair_cache_(K{}, V{}) {}
+		friend class map;
+
+	   public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = map::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer =
+			std::conditional_t<Const, const value_type*, value_type*>;
+		using reference =
+			std::conditional_t<Const, const value_type&, value_type&>;
+
+		basic_iterator() = default;
+
+		basic_iterator(tree_node<K, V>* node,
+					   const avl_balanced_tree<K, V>* tree) noexcept
+			: node_(node), tree_(tree)
+		{
+		}
 
-		explicit iterator(tree_node<K, V>* root, bool is_end = false)
-			: current_(nullptr), pair_cache_(K{}, V{})
+		operator basic_iterator<true>() const noexcept
 		{
-			// TODO: Реализовать инициализацию итератора
-			// Для begin(): нужно найти самый левый узел
-			// Для end(): current_ должен остаться nullptr
+			return basic_iterator<true>(node_, tree_);
 		}
 
-		typename iterator::reference operator*() const override
+		reference operator*() const { return node_->data; }
+
+		pointer operator->() const { return &node_->data; }
+
+		basic_iterator& operator++()
 		{
-			// TODO: Реализовать разыменование
-			// Нужно вернуть std::pair<const K, V> с текущим ключом и значением
-			return pair_cache_;
+			if (node_->right != nullptr)
+			{
+				node_ = leftmost_(node_->right);
+				return *this;
+			}
+			tree_node<K, V>* child = node_;
+			node_ = node_->parent;
+			while (node_ != nullptr && child == node_->right)
+			{
+				child = node_;
+				node_ = node_->parent;
+			}
+			return *this;
 		}
 
-		typename iterator::pointer operator->() const override
+		basic_iterator operator++(int)
 		{
-			// TODO: Реализовать оператор стрелки
-			return &pair_cache_;
+			basic_iterator tmp = *this;
+			++*this;
+			return tmp;
 		}
 
-		iterator& operator++() override
+		basic_iterator& operator--()
 		{
-			// TODO: Реализовать переход к следующему элементу (in-order)
-			// Подсказка: используйте стек для обхода дерева
+			if (node_ == nullptr)
+			{
+				node_ = rightmost_(
+					const_cast<tree_node<K, V>*>(tree_->get_root()));
+				return *this;
+			}
+			if (node_->left != nullptr)
+			{
+				node_ = rightmost_(node_->left);
+				return *this;
+			}
+			tree_node<K, V>* child = node_;
+			node_ = node_->parent;
+			while (node_ != nullptr && child == node_->left)
+			{
+				child = node_;
+				node_ = node_->parent;
+			}
 			return *this;
 		}
 
-		iterator operator++(int) override
+		basic_iterator operator--(int)
 		{
-			iterator temp = *this;
-			++(*this);
-			return temp;
+			basic_iterator tmp = *this;
+			--*this;
+			return tmp;
 		}
 
-		iterator& operator--() override
+		basic_iterator& operator+=(const difference_type& n)
 		{
-			// Необязательно для bidirectional_iterator в этой реализации
+			for (difference_type i = 0; i < n; ++i)
+			{
+				++*this;
+			}
+			for (difference_type i = 0; i > n; --i)
+			{
+				--*this;
+			}
 			return *this;
 		}
 
-		iterator operator--(int) override
+		basic_iterator& operator-=(const difference_type& n)
 		{
-			// Необязательно для bidirectional_iterator в этой реализации
-			return *this;
+			return *this += -n;
 		}
 
-		iterator& operator+=(
-			const typename iterator::difference_type& n) override
+		basic_iterator operator+(const difference_type& n) const
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			basic_iterator tmp = *this;
+			return tmp += n;
 		}
 
-		iterator& operator-=(
-			const typename iterator::difference_type& n) override
+		basic_iterator operator-(const difference_type& n) const
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			basic_iterator tmp = *this;
+			return tmp -= n;
 		}
 
-		iterator operator+(
-			const typename iterator::difference_type& n) const override
+		// Число шагов вперёд от other до *this; other не должен стоять после
+		// *this.
+		difference_type operator-(const basic_iterator& other) const
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			difference_type count = 0;
+			for (basic_iterator it = other; it != *this; ++it)
+			{
+				++count;
+			}
+			return count;
 		}
 
-		iterator operator-(
-			const typename iterator::difference_type& n) const override
+		bool operator==(const basic_iterator& other) const
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			return node_ == other.node_;
 		}
 
-		bool operator==(const iterator& other) const override
+		bool operator!=(const basic_iterator& other) const
 		{
-			return current_ == other.current_;
+			return node_ != other.node_;
 		}
 
-		bool operator!=(const iterator& other) const override
+		explicit operator bool() const { return node_ != nullptr; }
+
+	   private:
+		// Спуск к крайнему узлу заранее подгружает второго потомка каждого
+		// узла на пути: обход вернётся к нему, когда поднимется обратно.
+		// Иначе каждый шаг ждал бы промаха по предыдущему узлу.
+		static tree_node<K, V>* leftmost_(tree_node<K, V>* node) noexcept
 		{
-			return current_ != other.current_;
+			while (node != nullptr && node->left != nullptr)
+			{
+				__builtin_prefetch(node->right);
+				node = node->left;
+			}
+			return node;
 		}
 
-		explicit operator bool() const override { return current_ != nullptr; }
-
-		typename iterator::difference_type operator-(
-			const iterator& other) const override
+		static tree_node<K, V>* rightmost_(tree_node<K, V>* node) noexcept
 		{
-			// Не требуется точное вычисление для bidirectional_iterator
-			return 0;
+			while (node != nullptr && node->right != nullptr)
+			{
+				__builtin_prefetch(node->left);
+				node = node->right;
+			}
+			return node;
 		}
+
+		tree_node<K, V>* node_ = nullptr;
+		const avl_balanced_tree<K, V>* tree_ = nullptr;
+	};
+
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	// Полуинтервал [first, last) для range-based for.
+	template <typename It>
+	struct basic_range
+	{
+		It begin() const noexcept { return first; }
+
+		It end() const noexcept { return last; }
+
+		bool empty() const noexcept { return first == last; }
+
+		It first;
+		It last;
 	};
 
 	map() = default;
@@ -369,22 +696,21 @@ class map
 		auto node = tree_.find(key);
 		if (node == nullptr)
 		{
-			tree_.insert(key, V());
-			node = tree_.find(key);
+			node = tree_.insert(key, V());
 		}
-		return node->value;
+		return node->value();
 	}
 
 	V* find(const K& key)
 	{
 		auto node = tree_.find(key);
-		return node ? &node->value : nullptr;
+		return node ? &node->value() : nullptr;
 	}
 
 	const V* find(const K& key) const
 	{
 		auto node = tree_.find(key);
-		return node ? &node->value : nullptr;
+		return node ? &node->value() : nullptr;
 	}
 
 	V& at(const K& key)
@@ -394,7 +720,7 @@ class map
 		{
 			throw std::out_of_range("Key not found in map");
 		}
-		return node->value;
+		return node->value();
 	}
 
 	const V& at(const K& key) const
@@ -404,7 +730,63 @@ class map
 		{
 			throw std::out_of_range("Key not found in map");
 		}
-		return node->value;
+		return node->value();
+	}
+
+	// Упорядоченные запросы. Граница ищется одним спуском за O(log n), а
+	// дальше итератор идёт по ссылкам на родителя, так что обход k
+	// элементов диапазона стоит O(log n + k).
+	iterator lower_bound(const K& key)
+	{
+		return make_iterator_(tree_.lower_bound(key));
+	}
+
+	const_iterator lower_bound(const K& key) const
+	{
+		return const_cast<map&>(*this).lower_bound(key);
+	}
+
+	iterator upper_bound(const K& key)
+	{
+		return make_iterator_(tree_.upper_bound(key));
+	}
+
+	const_iterator upper_bound(const K& key) const
+	{
+		return const_cast<map&>(*this).upper_bound(key);
+	}
+
+	// Ключи уникальны: за lower_bound идёт не больше одного равного.
+	std::pair<iterator, iterator> equal_range(const K& key)
+	{
+		iterator first = lower_bound(key);
+		iterator last = first;
+		if (first != end() && !(key < first->first))
+		{
+			++last;
+		}
+		return {first, last};
+	}
+
+	std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return const_cast<map&>(*this).equal_range(key);
+	}
+
+	// Элементы с ключами из [from, to); пусто, если to <= from.
+	basic_range<iterator> range(const K& from, const K& to)
+	{
+		if (!(from < to))
+		{
+			return {end(), end()};
+		}
+		return {lower_bound(from), lower_bound(to)};
+	}
+
+	basic_range<const_iterator> range(const K& from, const K& to) const
+	{
+		auto result = const_cast<map&>(*this).range(from, to);
+		return {result.first, result.last};
 	}
 
 	// Удаление
@@ -419,22 +801,40 @@ class map
 	bool empty() const { return tree_.empty(); }
 
 	// Очистка
-	void clear()
-	{
-		tree_.~avl_balanced_tree();
-		new (&tree_) avl_balanced_tree<K, V>();
-	}
+	void clear() { tree_.clear(); }
 
 	void print() { tree_.print(); }
 
 	void inorder_print() { tree_.inorder_print(); }
 
 	// Итераторы
-	iterator begin() { return iterator(tree_.get_root(), false); }
+	iterator begin() noexcept
+	{
+		return iterator(iterator::leftmost_(tree_.get_root()), &tree_);
+	}
+
+	iterator end() noexcept { return iterator(nullptr, &tree_); }
 
-	iterator end() { return iterator(tree_.get_root(), true); }
+	const_iterator begin() const noexcept
+	{
+		return const_cast<map&>(*this).begin();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(nullptr, &tree_);
+	}
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
 
    private:
+	iterator make_iterator_(const tree_node<K, V>* node) noexcept
+	{
+		return iterator(const_cast<tree_node<K, V>*>(node), &tree_);
+	}
+
 	avl_balanced_tree<K, V> tree_;
 };
 
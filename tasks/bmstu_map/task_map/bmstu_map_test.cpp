@@ -1,9 +1,21 @@
 #include "bmstu_map.h"
 
 #include <gtest/gtest.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
 #include <string>
+#include <type_traits>
 #include <vector>
+#include "bench.h"
 
 TEST(MapTest, BasicInsertAndAccess)
 {
@@ -348,4 +360,470 @@ TEST(MapTest, RangeBasedForDemo)
 
 	EXPECT_EQ(catalog.size(), 5);
 	EXPECT_EQ(catalog["apple"], "fruit");
-}
\ No newline at end of file
+}
+
+namespace
+{
+// Проверяет упорядоченность, высоты и баланс; возвращает высоту.
+template <typename K, typename V>
+int check_avl(const bmstu::tree_node<K, V>* node,
+			  const K* lower,
+			  const K* upper,
+			  size_t& count)
+{
+	if (node == nullptr)
+	{
+		return 0;
+	}
+	++count;
+	EXPECT_TRUE(lower == nullptr || *lower < node->key());
+	EXPECT_TRUE(upper == nullptr || node->key() < *upper);
+	EXPECT_TRUE(node->left == nullptr || node->left->parent == node);
+	EXPECT_TRUE(node->right == nullptr || node->right->parent == node);
+	const int left = check_avl(node->left, lower, &node->key(), count);
+	const int right = check_avl(node->right, &node->key(), upper, count);
+	EXPECT_LE(std::abs(left - right), 1);
+	EXPECT_EQ(node->height, std::max(left, right) + 1);
+	return std::max(left, right) + 1;
+}
+}  // namespace
+
+TEST(MapTest, IteratorBidirectional)
+{
+	bmstu::map<int, std::string> map;
+	ASSERT_EQ(map.begin(), map.end());
+	for (int key : {50, 20, 80, 10, 30, 70, 90, 25, 35, 60})
+	{
+		map.insert(key, std::to_string(key));
+	}
+	std::vector<int> backward;
+	for (auto it = map.end(); it != map.begin();)
+	{
+		--it;
+		backward.push_back(it->first);
+	}
+	ASSERT_EQ(backward,
+			  (std::vector<int>{90, 80, 70, 60, 50, 35, 30, 25, 20, 10}));
+
+	auto it = map.begin();
+	ASSERT_EQ((it++)->first, 10);
+	ASSERT_EQ(it->first, 20);
+	ASSERT_EQ((it--)->first, 20);
+	ASSERT_EQ(it, map.begin());
+	ASSERT_EQ((map.begin() + 4)->first, 35);
+	ASSERT_EQ(map.end() - map.begin(), 10);
+
+	// Ссылка ведёт прямо в узел: запись видна через find().
+	auto& entry = *(map.begin() + 2);
+	entry.second = "twenty-five";
+	ASSERT_EQ(*map.find(25), "twenty-five");
+	ASSERT_EQ(&entry.second, map.find(25));
+
+	map.erase(50);
+	map.erase(10);
+	const auto& view = map;
+	std::vector<int> forward;
+	for (auto cit = view.cbegin(); cit != view.cend(); ++cit)
+	{
+		forward.push_back(cit->first);
+	}
+	ASSERT_EQ(forward, (std::vector<int>{20, 25, 30, 35, 60, 70, 80, 90}));
+	bmstu::map<int, std::string>::const_iterator last = --map.end();
+	ASSERT_EQ(last->first, 90);
+
+	// Узел и дерево, без указателя на vtable.
+	ASSERT_EQ(sizeof(bmstu::map<int, std::string>::iterator),
+			  2 * sizeof(void*));
+	ASSERT_TRUE((std::is_same_v<
+				 std::iterator_traits<
+					 bmstu::map<int, std::string>::const_iterator>::reference,
+				 const std::pair<const int, std::string>&>));
+}
+
+TEST(MapTest, BoundsAndRanges)
+{
+	bmstu::map<int, int> map;
+	ASSERT_EQ(map.lower_bound(5), map.end());
+	ASSERT_TRUE(map.range(0, 10).empty());
+	for (int key = 10; key <= 100; key += 10)
+	{
+		map.insert(key, key * 2);
+	}
+	ASSERT_EQ(map.lower_bound(30)->first, 30);
+	ASSERT_EQ(map.lower_bound(31)->first, 40);
+	ASSERT_EQ(map.lower_bound(5)->first, 10);
+	ASSERT_EQ(map.lower_bound(101), map.end());
+	ASSERT_EQ(map.upper_bound(30)->first, 40);
+	ASSERT_EQ(map.upper_bound(29)->first, 30);
+	ASSERT_EQ(map.upper_bound(100), map.end());
+
+	auto [first, last] = map.equal_range(50);
+	ASSERT_EQ(first->first, 50);
+	ASSERT_EQ(last->first, 60);
+	auto missing = map.equal_range(55);
+	ASSERT_EQ(missing.first, missing.second);
+	ASSERT_EQ(missing.first->first, 60);
+	auto tail = map.equal_range(100);
+	ASSERT_EQ(tail.second, map.end());
+
+	std::vector<int> keys;
+	for (auto& [key, value] : map.range(25, 70))
+	{
+		keys.push_back(key);
+		value = -value;
+	}
+	ASSERT_EQ(keys, (std::vector<int>{30, 40, 50, 60}));
+	ASSERT_EQ(map.at(40), -80);
+	ASSERT_EQ(map.at(70), 140);
+	ASSERT_TRUE(map.range(70, 70).empty());
+	ASSERT_TRUE(map.range(80, 20).empty());
+
+	const auto& view = map;
+	keys.clear();
+	for (const auto& entry : view.range(90, 1'000))
+	{
+		keys.push_back(entry.first);
+	}
+	ASSERT_EQ(keys, (std::vector<int>{90, 100}));
+	ASSERT_EQ(view.lower_bound(45)->first, 50);
+	ASSERT_EQ(view.equal_range(10).first, view.begin());
+	ASSERT_EQ(--view.upper_bound(1'000), --view.end());
+}
+
+TEST(MapTest, NodesComeFromPool)
+{
+	bmstu::avl_balanced_tree<int, std::string> tree;
+	for (int i = 0; i < 1'000; ++i)
+	{
+		tree.insert(i, std::to_string(i));
+	}
+	const size_t slabs = tree.get_pool().slab_count();
+	ASSERT_LT(slabs, 16u);
+	for (int i = 0; i < 1'000; i += 2)
+	{
+		tree.remove(i);
+	}
+	for (int i = 0; i < 1'000; i += 2)
+	{
+		tree.insert(i, "again");
+	}
+	// Удалённые узлы переиспользуются, новых слэбов не нужно.
+	ASSERT_EQ(tree.get_pool().slab_count(), slabs);
+	ASSERT_EQ(tree.find(10)->value(), "again");
+	ASSERT_EQ(tree.find(11)->value(), "11");
+	tree.clear();
+	ASSERT_TRUE(tree.empty());
+	ASSERT_EQ(tree.get_pool().slab_count(), 0u);
+	tree.insert(1, "one");
+	ASSERT_EQ(tree.find(1)->value(), "one");
+}
+
+TEST(MapTest, RandomizedMatchesStdMap)
+{
+	std::mt19937 gen(47);
+	bmstu::avl_balanced_tree<int, int> tree;
+	std::map<int, int> reference;
+	for (int step = 0; step < 20'000; ++step)
+	{
+		const int key = static_cast<int>(gen() % 2'000);
+		if (gen() % 3 == 0)
+		{
+			tree.remove(key);
+			reference.erase(key);
+		}
+		else
+		{
+			tree.insert(key, step);
+			reference[key] = step;
+		}
+		if (step % 1'000 == 0)
+		{
+			size_t count = 0;
+			check_avl<int, int>(tree.get_root(), nullptr, nullptr, count);
+			ASSERT_EQ(count, reference.size());
+			ASSERT_TRUE(tree.get_root() == nullptr ||
+						tree.get_root()->parent == nullptr);
+		}
+	}
+	size_t count = 0;
+	check_avl<int, int>(tree.get_root(), nullptr, nullptr, count);
+	ASSERT_EQ(count, reference.size());
+	ASSERT_EQ(tree.size(), reference.size());
+	for (const auto& [key, value] : reference)
+	{
+		ASSERT_NE(tree.find(key), nullptr);
+		ASSERT_EQ(tree.find(key)->value(), value);
+	}
+	for (int key = 0; key < 2'000; ++key)
+	{
+		tree.remove(key);
+	}
+	ASSERT_TRUE(tree.empty());
+	ASSERT_EQ(tree.get_root(), nullptr);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(MapBench, DISABLED_InsertEraseVsStdMap)
+{
+	// 1e7 вставок и 1e7 удалений: деревом на 1e4 ключей (всё в кэше) и
+	// одним деревом на 1e7 ключей (упирается в промахи).
+	constexpr size_t kOps = 10'000'000;
+	for (size_t size : {10'000u, 10'000'000u})
+	{
+		std::mt19937_64 gen(size);
+		std::vector<int64_t> keys(size);
+		for (int64_t& key : keys)
+		{
+			key = static_cast<int64_t>(gen() >> 1);
+		}
+		std::vector<int64_t> erase_order = keys;
+		std::shuffle(erase_order.begin(), erase_order.end(), gen);
+		const size_t rounds = kOps / size;
+
+		bmstu::map<int64_t, int64_t> avl;
+		std::map<int64_t, int64_t> reference;
+		double avl_insert_ms = 0;
+		double avl_erase_ms = 0;
+		double std_insert_ms = 0;
+		double std_erase_ms = 0;
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			avl_insert_ms += measure_ms(
+				[&]
+				{
+					for (int64_t key : keys)
+					{
+						avl.insert(key, key);
+					}
+				});
+			avl_erase_ms += measure_ms(
+				[&]
+				{
+					for (int64_t key : erase_order)
+					{
+						avl.erase(key);
+					}
+				});
+			ASSERT_TRUE(avl.empty());
+
+			std_insert_ms += measure_ms(
+				[&]
+				{
+					for (int64_t key : keys)
+					{
+						reference.emplace(key, key);
+					}
+				});
+			std_erase_ms += measure_ms(
+				[&]
+				{
+					for (int64_t key : erase_order)
+					{
+						reference.erase(key);
+					}
+				});
+			ASSERT_TRUE(reference.empty());
+		}
+		std::cout << size << " keys, ns/op insert / erase: bmstu::map "
+				  << avl_insert_ms * 1e6 / kOps << " / "
+				  << avl_erase_ms * 1e6 / kOps << ", std::map "
+				  << std_insert_ms * 1e6 / kOps << " / "
+				  << std_erase_ms * 1e6 / kOps << "\n";
+	}
+}
+
+namespace
+{
+// Байт кучи, занятых сейчас (только glibc); 0, если узнать нельзя.
+size_t heap_in_use()
+{
+#if defined(__GLIBC__)
+	// Крупные блоки glibc отдаёт через mmap, они учтены отдельно.
+	const auto info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+#else
+	return 0;
+#endif
+}
+}  // namespace
+
+TEST(MapBench, DISABLED_MemoryAndInsertThroughput)
+{
+	for (size_t size : {100'000u, 1'000'000u, 10'000'000u})
+	{
+		std::mt19937_64 gen(size);
+		std::vector<int64_t> keys(size);
+		for (int64_t& key : keys)
+		{
+			key = static_cast<int64_t>(gen() >> 1);
+		}
+
+		const size_t avl_before = heap_in_use();
+		auto avl = std::make_unique<bmstu::map<int64_t, int64_t>>();
+		const double avl_ms = measure_ms(
+			[&]
+			{
+				for (int64_t key : keys)
+				{
+					avl->insert(key, key);
+				}
+			});
+		const double avl_bytes =
+			static_cast<double>(heap_in_use() - avl_before) / avl->size();
+		const double avl_clear_ms = measure_ms([&] { avl->clear(); });
+		avl.reset();
+
+		const size_t std_before = heap_in_use();
+		auto reference = std::make_unique<std::map<int64_t, int64_t>>();
+		const double std_ms = measure_ms(
+			[&]
+			{
+				for (int64_t key : keys)
+				{
+					reference->emplace(key, key);
+				}
+			});
+		const double std_bytes =
+			static_cast<double>(heap_in_use() - std_before) /
+			reference->size();
+		const double std_clear_ms = measure_ms([&] { reference->clear(); });
+
+		std::cout << size << " int64->int64, M inserts/s, bytes/entry, "
+				  << "clear ms: bmstu::map " << size / avl_ms / 1e3 << ", "
+				  << avl_bytes << ", " << avl_clear_ms << "; std::map "
+				  << size / std_ms / 1e3 << ", " << std_bytes << ", "
+				  << std_clear_ms << "; sizeof(tree_node) "
+				  << sizeof(bmstu::tree_node<int64_t, int64_t>) << "\n";
+	}
+}
+
+TEST(MapBench, DISABLED_Traversal)
+{
+	constexpr size_t kPasses = 20;
+	for (size_t size : {1'000u, 100'000u, 1'000'000u})
+	{
+		std::mt19937_64 gen(size);
+		bmstu::map<int64_t, int64_t> avl;
+		std::map<int64_t, int64_t> reference;
+		for (size_t i = 0; i < size; ++i)
+		{
+			const auto key = static_cast<int64_t>(gen() >> 1);
+			avl.insert(key, key);
+			reference.emplace(key, key);
+		}
+		int64_t avl_sum = 0;
+		const double avl_ms = measure_ms(
+			[&]
+			{
+				for (size_t pass = 0; pass < kPasses; ++pass)
+				{
+					for (const auto& [key, value] : avl)
+					{
+						avl_sum += value;
+					}
+				}
+			});
+		// Постфиксный ++ копирует итератор на каждом шаге.
+		int64_t copy_sum = 0;
+		const double copy_ms = measure_ms(
+			[&]
+			{
+				for (size_t pass = 0; pass < kPasses; ++pass)
+				{
+					for (auto it = avl.begin(); it != avl.end(); it++)
+					{
+						copy_sum += it->second;
+					}
+				}
+			});
+		int64_t std_sum = 0;
+		const double std_ms = measure_ms(
+			[&]
+			{
+				for (size_t pass = 0; pass < kPasses; ++pass)
+				{
+					for (const auto& [key, value] : reference)
+					{
+						std_sum += value;
+					}
+				}
+			});
+		ASSERT_EQ(avl_sum, std_sum);
+		ASSERT_EQ(copy_sum, std_sum);
+		const double steps = static_cast<double>(size * kPasses);
+		std::cout << size << " keys, full traversal ns/element: bmstu::map "
+				  << avl_ms * 1e6 / steps << " (it++ " << copy_ms * 1e6 / steps
+				  << "), std::map " << std_ms * 1e6 / steps << "\n";
+	}
+}
+
+TEST(MapBench, DISABLED_RangeScan)
+{
+	// Ключи идут с шагом 16, как отметки времени; окно [t, t + width)
+	// начинается в случайной точке.
+	constexpr size_t kSize = 1'000'000;
+	constexpr size_t kElements = 20'000'000;
+	bmstu::map<int64_t, int64_t> avl;
+	std::map<int64_t, int64_t> reference;
+	std::vector<int64_t> keys(kSize);
+	for (size_t i = 0; i < kSize; ++i)
+	{
+		keys[i] = static_cast<int64_t>(i) * 16;
+	}
+	std::mt19937_64 gen(50);
+	std::vector<int64_t> order = keys;
+	std::shuffle(order.begin(), order.end(), gen);
+	for (int64_t key : order)
+	{
+		avl.insert(key, key);
+		reference.emplace(key, key);
+	}
+	std::cout << "1e6 keys, range scans: ns/scan, ns/element\n";
+	for (size_t width : {1u, 16u, 256u, 4'096u, 65'536u})
+	{
+		const size_t scans = std::max<size_t>(kElements / width, 1) / 10;
+		std::vector<int64_t> starts(scans);
+		for (int64_t& start : starts)
+		{
+			start = static_cast<int64_t>(gen() % (kSize * 16));
+		}
+		const auto span = static_cast<int64_t>(width) * 16;
+
+		int64_t avl_sum = 0;
+		size_t visited = 0;
+		const double avl_ms = measure_ms(
+			[&]
+			{
+				for (int64_t start : starts)
+				{
+					for (const auto& [key, value] : avl.range(start,
+															  start + span))
+					{
+						avl_sum += value;
+						++visited;
+					}
+				}
+			});
+		int64_t std_sum = 0;
+		const double std_ms = measure_ms(
+			[&]
+			{
+				for (int64_t start : starts)
+				{
+					const auto last = reference.lower_bound(start + span);
+					for (auto it = reference.lower_bound(start); it != last;
+						 ++it)
+					{
+						std_sum += it->second;
+					}
+				}
+			});
+		ASSERT_EQ(avl_sum, std_sum);
+		std::cout << "width " << width << ": bmstu::map "
+				  << avl_ms * 1e6 / scans << ", "
+				  << avl_ms * 1e6 / std::max<size_t>(visited, 1)
+				  << "; std::map " << std_ms * 1e6 / scans << ", "
+				  << std_ms * 1e6 / std::max<size_t>(visited, 1) << "\n";
+	}
+}
@@ -0,0 +1,538 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Двоичный формат simple_vector: заголовок на 64 байта и один буфер данных.
+// Для тривиально копируемых T буфер — сырые байты массива: запись идёт одним
+// writev, чтение — одним read в готовый буфер или через mmap (binary_view).
+// Остальные типы кодируются поэлементно через binary_codec<T>.
+namespace detail
+{
+constexpr char kBinaryMagic[8] = {'B', 'M', 'S', 'T', 'U', 'S', 'V', '1'};
+constexpr size_t kBinaryDataOffset = 64;
+
+enum class binary_encoding : uint32_t
+{
+	raw = 0,
+	elementwise = 1
+};
+
+struct binary_header
+{
+	char magic[8];
+	uint32_t elem_size;
+	binary_encoding encoding;
+	uint64_t count;
+	uint64_t payload_bytes;
+	char reserved[kBinaryDataOffset - 32];
+};
+static_assert(sizeof(binary_header) == kBinaryDataOffset);
+
+[[noreturn]] inline void throw_binary_errno(const char* what)
+{
+	throw std::system_error(errno, std::generic_category(),
+							std::string("binary_io: ") + what);
+}
+
+// Курсор по закодированному буферу; выход за конец — исключение.
+class binary_reader
+{
+   public:
+	binary_reader(const char* first, const char* last) noexcept
+		: pos_(first), end_(last)
+	{
+	}
+
+	void read(void* dst, size_t bytes)
+	{
+		if (static_cast<size_t>(end_ - pos_) < bytes)
+		{
+			throw std::runtime_error("binary_io: truncated payload");
+		}
+		std::memcpy(dst, pos_, bytes);
+		pos_ += bytes;
+	}
+
+	bool at_end() const noexcept { return pos_ == end_; }
+
+	size_t remaining() const noexcept
+	{
+		return static_cast<size_t>(end_ - pos_);
+	}
+
+   private:
+	const char* pos_;
+	const char* end_;
+};
+}  // namespace detail
+
+// Поэлементное кодирование. Специализируйте для своих типов.
+template <typename T>
+struct binary_codec;
+
+template <typename T>
+	requires std::is_trivially_copyable_v<T>
+struct binary_codec<T>
+{
+	static void encode(std::string& out, const T& value)
+	{
+		out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	static void decode(detail::binary_reader& in, T& value)
+	{
+		in.read(&value, sizeof(T));
+	}
+};
+
+template <>
+struct binary_codec<std::string>
+{
+	static void encode(std::string& out, const std::string& value)
+	{
+		binary_codec<uint64_t>::encode(out, value.size());
+		out.append(value);
+	}
+
+	static void decode(detail::binary_reader& in, std::string& value)
+	{
+		uint64_t size = 0;
+		binary_codec<uint64_t>::decode(in, size);
+		if (size > in.remaining())
+		{
+			throw std::runtime_error("binary_io: truncated payload");
+		}
+		value.resize(size);
+		in.read(value.data(), size);
+	}
+};
+
+template <typename A, typename B>
+	requires(!std::is_trivially_copyable_v<std::pair<A, B>>)
+struct binary_codec<std::pair<A, B>>
+{
+	static void encode(std::string& out, const std::pair<A, B>& value)
+	{
+		binary_codec<A>::encode(out, value.first);
+		binary_codec<B>::encode(out, value.second);
+	}
+
+	static void decode(detail::binary_reader& in, std::pair<A, B>& value)
+	{
+		binary_codec<A>::decode(in, value.first);
+		binary_codec<B>::decode(in, value.second);
+	}
+};
+
+template <typename U>
+struct binary_codec<simple_vector<U>>
+{
+	static void encode(std::string& out, const simple_vector<U>& value)
+	{
+		binary_codec<uint64_t>::encode(out, value.size());
+		for (const U& item : value)
+		{
+			binary_codec<U>::encode(out, item);
+		}
+	}
+
+	static void decode(detail::binary_reader& in, simple_vector<U>& value)
+	{
+		uint64_t size = 0;
+		binary_codec<uint64_t>::decode(in, size);
+		value.clear();
+		// Длина не проверена: резервируем не больше, чем осталось байт.
+		value.reserve(std::min<uint64_t>(size, in.remaining()));
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			U item{};
+			binary_codec<U>::decode(in, item);
+			value.push_back(std::move(item));
+		}
+	}
+};
+
+namespace detail
+{
+// Дописывает все iov целиком, продолжая после частичных записей.
+inline void write_all(int fd, iovec* iov, int count)
+{
+	while (count > 0)
+	{
+		const ssize_t written = ::writev(fd, iov, count);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throw_binary_errno("writev");
+		}
+		size_t left = static_cast<size_t>(written);
+		while (count > 0 && left >= iov->iov_len)
+		{
+			left -= iov->iov_len;
+			++iov;
+			--count;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+			iov->iov_len -= left;
+		}
+	}
+}
+
+inline void read_all(int fd, void* dst, size_t bytes)
+{
+	char* pos = static_cast<char*>(dst);
+	while (bytes > 0)
+	{
+		const ssize_t got = ::read(fd, pos, bytes);
+		if (got < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throw_binary_errno("read");
+		}
+		if (got == 0)
+		{
+			throw std::runtime_error("binary_io: unexpected end of file");
+		}
+		pos += got;
+		bytes -= static_cast<size_t>(got);
+	}
+}
+
+template <typename T>
+binary_header make_header(uint64_t count, uint64_t payload_bytes)
+{
+	binary_header header = {};
+	std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+	header.count = count;
+	header.payload_bytes = payload_bytes;
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		header.elem_size = sizeof(T);
+		header.encoding = binary_encoding::raw;
+	}
+	else
+	{
+		header.elem_size = 0;
+		header.encoding = binary_encoding::elementwise;
+	}
+	return header;
+}
+
+template <typename T>
+void check_header(const binary_header& header)
+{
+	const binary_header expected = make_header<T>(0, 0);
+	if (std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0 ||
+		header.elem_size != expected.elem_size ||
+		header.encoding != expected.encoding ||
+		(header.encoding == binary_encoding::raw &&
+		 (header.count > header.payload_bytes / sizeof(T) ||
+		  header.payload_bytes != header.count * sizeof(T))))
+	{
+		throw std::runtime_error("binary_io: incompatible header");
+	}
+}
+
+// Сверяет длину из заголовка с остатком обычного файла, чтобы испорченный
+// заголовок дал runtime_error, а не огромное выделение памяти. Размер канала
+// или сокета заранее не известен — для них проверки нет.
+inline void check_payload_fits(int fd, uint64_t payload_bytes)
+{
+	struct stat st = {};
+	if (::fstat(fd, &st) != 0)
+	{
+		throw_binary_errno("fstat");
+	}
+	if (!S_ISREG(st.st_mode))
+	{
+		return;
+	}
+	const off_t pos = ::lseek(fd, 0, SEEK_CUR);
+	if (pos < 0)
+	{
+		throw_binary_errno("lseek");
+	}
+	if (pos > st.st_size ||
+		payload_bytes > static_cast<uint64_t>(st.st_size - pos))
+	{
+		throw std::runtime_error("binary_io: truncated payload");
+	}
+}
+
+template <typename T>
+binary_header read_header(int fd)
+{
+	binary_header header;
+	read_all(fd, &header, sizeof(header));
+	check_header<T>(header);
+	check_payload_fits(fd, header.payload_bytes);
+	return header;
+}
+
+// Закрывает дескриптор при выходе из области видимости.
+class file_descriptor
+{
+   public:
+	file_descriptor(const std::string& path, int flags)
+		: fd_(::open(path.c_str(), flags, 0644))
+	{
+		if (fd_ < 0)
+		{
+			throw_binary_errno("open");
+		}
+	}
+
+	file_descriptor(const file_descriptor& other) = delete;
+	file_descriptor& operator=(const file_descriptor& other) = delete;
+
+	~file_descriptor() { ::close(fd_); }
+
+	int get() const noexcept { return fd_; }
+
+   private:
+	int fd_;
+};
+}  // namespace detail
+
+template <typename T>
+void save_binary(int fd, const simple_vector<T>& v)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		detail::binary_header header =
+			detail::make_header<T>(v.size(), v.size() * sizeof(T));
+		iovec iov[2] = {{&header, sizeof(header)},
+						{const_cast<T*>(v.data()), v.size() * sizeof(T)}};
+		detail::write_all(fd, iov, v.empty() ? 1 : 2);
+	}
+	else
+	{
+		std::string payload;
+		for (const T& item : v)
+		{
+			binary_codec<T>::encode(payload, item);
+		}
+		detail::binary_header header =
+			detail::make_header<T>(v.size(), payload.size());
+		iovec iov[2] = {{&header, sizeof(header)},
+						{payload.data(), payload.size()}};
+		detail::write_all(fd, iov, payload.empty() ? 1 : 2);
+	}
+}
+
+template <typename T>
+void save_binary(const std::string& path, const simple_vector<T>& v)
+{
+	detail::file_descriptor fd(path, O_WRONLY | O_CREAT | O_TRUNC);
+	save_binary(fd.get(), v);
+}
+
+// Читает в out; если ёмкости хватает, память не перевыделяется.
+template <typename T>
+void load_binary(int fd, simple_vector<T>& out)
+{
+	const detail::binary_header header = detail::read_header<T>(fd);
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		out.resize(header.count);
+		detail::read_all(fd, out.data(), header.payload_bytes);
+	}
+	else
+	{
+		std::string payload(header.payload_bytes, '\0');
+		detail::read_all(fd, payload.data(), payload.size());
+		detail::binary_reader in(payload.data(),
+								 payload.data() + payload.size());
+		out.clear();
+		out.reserve(std::min(header.count, header.payload_bytes));
+		for (uint64_t i = 0; i < header.count; ++i)
+		{
+			T item{};
+			binary_codec<T>::decode(in, item);
+			out.push_back(std::move(item));
+		}
+		if (!in.at_end())
+		{
+			throw std::runtime_error("binary_io: trailing bytes in payload");
+		}
+	}
+}
+
+template <typename T>
+void load_binary(const std::string& path, simple_vector<T>& out)
+{
+	detail::file_descriptor fd(path, O_RDONLY);
+	load_binary(fd.get(), out);
+}
+
+// Читает прямо в буфер вызывающего; возвращает число элементов.
+template <typename T>
+	requires std::is_trivially_copyable_v<T>
+size_t load_binary(int fd, std::span<T> out)
+{
+	const detail::binary_header header = detail::read_header<T>(fd);
+	if (header.count > out.size())
+	{
+		throw std::length_error("binary_io: buffer is too small");
+	}
+	detail::read_all(fd, out.data(), header.payload_bytes);
+	return header.count;
+}
+
+template <typename T>
+	requires std::is_trivially_copyable_v<T>
+size_t load_binary(const std::string& path, std::span<T> out)
+{
+	detail::file_descriptor fd(path, O_RDONLY);
+	return load_binary(fd.get(), out);
+}
+
+// Неизменяемое представление сохранённого вектора через mmap: открытие не
+// копирует данные, страницы подгружаются по мере чтения.
+template <typename T>
+class binary_view
+{
+	static_assert(std::is_trivially_copyable_v<T>,
+				  "binary_view maps raw bytes of T");
+	static_assert(alignof(T) <= detail::kBinaryDataOffset,
+				  "binary_view supports alignof(T) <= 64");
+
+   public:
+	using value_type = T;
+	using const_iterator = const T*;
+
+	explicit binary_view(const std::string& path)
+	{
+		detail::file_descriptor fd(path, O_RDONLY);
+		struct stat st = {};
+		if (::fstat(fd.get(), &st) != 0)
+		{
+			detail::throw_binary_errno("fstat");
+		}
+		const size_t bytes = static_cast<size_t>(st.st_size);
+		if (bytes < detail::kBinaryDataOffset)
+		{
+			throw std::runtime_error("binary_io: file is too small");
+		}
+		void* base =
+			::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+		if (base == MAP_FAILED)
+		{
+			detail::throw_binary_errno("mmap");
+		}
+		base_ = base;
+		mapped_bytes_ = bytes;
+		const auto* header = static_cast<const detail::binary_header*>(base_);
+		try
+		{
+			detail::check_header<T>(*header);
+			if (header->payload_bytes > bytes - detail::kBinaryDataOffset)
+			{
+				throw std::runtime_error("binary_io: truncated payload");
+			}
+		}
+		catch (...)
+		{
+			unmap_();
+			throw;
+		}
+		size_ = header->count;
+	}
+
+	binary_view(const binary_view& other) = delete;
+	binary_view& operator=(const binary_view& other) = delete;
+
+	binary_view(binary_view&& other) noexcept { swap(other); }
+
+	binary_view& operator=(binary_view&& other) noexcept
+	{
+		if (this != &other)
+		{
+			binary_view tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~binary_view() { unmap_(); }
+
+	size_t size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	const T* data() const noexcept
+	{
+		if (base_ == nullptr)
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<const T*>(static_cast<const char*>(base_) +
+										  detail::kBinaryDataOffset);
+	}
+
+	const_iterator begin() const noexcept { return data(); }
+
+	const_iterator end() const noexcept { return data() + size_; }
+
+	const T& operator[](size_t index) const noexcept { return data()[index]; }
+
+	const T& at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data()[index];
+	}
+
+	std::span<const T> span() const noexcept { return {data(), size_}; }
+
+	void swap(binary_view& other) noexcept
+	{
+		std::swap(base_, other.base_);
+		std::swap(mapped_bytes_, other.mapped_bytes_);
+		std::swap(size_, other.size_);
+	}
+
+   private:
+	void unmap_() noexcept
+	{
+		if (base_ != nullptr)
+		{
+			::munmap(base_, mapped_bytes_);
+			base_ = nullptr;
+		}
+	}
+
+	void* base_ = nullptr;
+	size_t mapped_bytes_ = 0;
+	size_t size_ = 0;
+};
+}  // namespace bmstu
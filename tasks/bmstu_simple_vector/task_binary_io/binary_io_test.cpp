@@ -0,0 +1,265 @@
+#include "binary_io.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "bench.h"
+
+namespace
+{
+struct sample
+{
+	int64_t id;
+	double value;
+};
+
+class temp_file
+{
+   public:
+	explicit temp_file(const char* name)
+		: path_((std::filesystem::temp_directory_path() / name).string())
+	{
+		std::filesystem::remove(path_);
+	}
+
+	~temp_file() { std::filesystem::remove(path_); }
+
+	const std::string& path() const { return path_; }
+
+   private:
+	std::string path_;
+};
+}  // namespace
+
+TEST(BinaryIo, RawRoundTrip)
+{
+	temp_file file("bmstu_binary_io_raw.bin");
+	bmstu::simple_vector<sample> v;
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		v.push_back({i, i * 0.25});
+	}
+	bmstu::save_binary(file.path(), v);
+	ASSERT_EQ(std::filesystem::file_size(file.path()),
+			  64 + 1000 * sizeof(sample));
+
+	bmstu::simple_vector<sample> loaded;
+	bmstu::load_binary(file.path(), loaded);
+	ASSERT_EQ(loaded.size(), 1000u);
+	ASSERT_EQ(loaded[999].id, 999);
+	ASSERT_EQ(loaded[999].value, 999 * 0.25);
+}
+
+TEST(BinaryIo, LoadIntoPresizedBuffer)
+{
+	temp_file file("bmstu_binary_io_span.bin");
+	bmstu::simple_vector<int> v(100);
+	std::iota(v.begin(), v.end(), 0);
+	bmstu::save_binary(file.path(), v);
+
+	std::vector<int> buffer(128, -1);
+	ASSERT_EQ(bmstu::load_binary(file.path(), std::span<int>(buffer)), 100u);
+	ASSERT_EQ(buffer[99], 99);
+	ASSERT_EQ(buffer[100], -1);
+
+	std::vector<int> small(10);
+	ASSERT_THROW(bmstu::load_binary(file.path(), std::span<int>(small)),
+				 std::length_error);
+
+	bmstu::simple_vector<int> reused;
+	reused.reserve(200);
+	const int* storage = reused.data();
+	bmstu::load_binary(file.path(), reused);
+	ASSERT_EQ(reused.data(), storage);
+	ASSERT_EQ(reused, v);
+}
+
+TEST(BinaryIo, MappedView)
+{
+	temp_file file("bmstu_binary_io_view.bin");
+	bmstu::simple_vector<double> v(5000, 1.5);
+	v[4999] = 7.0;
+	bmstu::save_binary(file.path(), v);
+
+	bmstu::binary_view<double> view(file.path());
+	ASSERT_EQ(view.size(), 5000u);
+	ASSERT_EQ(view[0], 1.5);
+	ASSERT_EQ(view.at(4999), 7.0);
+	ASSERT_THROW(view.at(5000), std::out_of_range);
+	ASSERT_EQ(std::accumulate(view.begin(), view.end(), 0.0),
+			  4999 * 1.5 + 7.0);
+
+	bmstu::binary_view<double> moved(std::move(view));
+	ASSERT_EQ(moved.span().size(), 5000u);
+	ASSERT_TRUE(view.empty());
+}
+
+TEST(BinaryIo, ElementwiseFallback)
+{
+	temp_file file("bmstu_binary_io_strings.bin");
+	bmstu::simple_vector<std::string> words{"", "alpha",
+											std::string(1000, 'x')};
+	bmstu::save_binary(file.path(), words);
+	bmstu::simple_vector<std::string> loaded{"stale"};
+	bmstu::load_binary(file.path(), loaded);
+	ASSERT_EQ(loaded, words);
+
+	temp_file nested("bmstu_binary_io_nested.bin");
+	bmstu::simple_vector<std::pair<std::string, bmstu::simple_vector<int>>>
+		table;
+	table.push_back({"a", {1, 2, 3}});
+	table.push_back({"b", {}});
+	bmstu::save_binary(nested.path(), table);
+	decltype(table) table_loaded;
+	bmstu::load_binary(nested.path(), table_loaded);
+	ASSERT_EQ(table_loaded.size(), 2u);
+	ASSERT_EQ(table_loaded[0].first, "a");
+	ASSERT_EQ(table_loaded[0].second, (bmstu::simple_vector<int>{1, 2, 3}));
+	ASSERT_TRUE(table_loaded[1].second.empty());
+}
+
+TEST(BinaryIo, EmptyVector)
+{
+	temp_file file("bmstu_binary_io_empty.bin");
+	bmstu::save_binary(file.path(), bmstu::simple_vector<int>());
+	bmstu::simple_vector<int> loaded{1, 2};
+	bmstu::load_binary(file.path(), loaded);
+	ASSERT_TRUE(loaded.empty());
+	ASSERT_TRUE(bmstu::binary_view<int>(file.path()).empty());
+}
+
+TEST(BinaryIo, RejectsIncompatibleFiles)
+{
+	temp_file file("bmstu_binary_io_bad.bin");
+	bmstu::save_binary(file.path(), bmstu::simple_vector<int>{1, 2, 3});
+	bmstu::simple_vector<int64_t> wrong_type;
+	ASSERT_THROW(bmstu::load_binary(file.path(), wrong_type),
+				 std::runtime_error);
+	ASSERT_THROW(bmstu::binary_view<std::string::value_type>(file.path()),
+				 std::runtime_error);
+
+	std::filesystem::resize_file(file.path(), 70);
+	bmstu::simple_vector<int> truncated;
+	ASSERT_THROW(bmstu::load_binary(file.path(), truncated),
+				 std::runtime_error);
+	ASSERT_THROW(bmstu::binary_view<int>(file.path()), std::runtime_error);
+
+	{
+		std::ofstream garbage(file.path(), std::ios::trunc);
+		garbage << "not a vector";
+	}
+	ASSERT_THROW(bmstu::load_binary(file.path(), truncated),
+				 std::runtime_error);
+	ASSERT_THROW(bmstu::load_binary("/nonexistent/dir/file.bin", truncated),
+				 std::system_error);
+}
+
+namespace
+{
+// Переписывает 64-битное поле заголовка по смещению offset.
+void patch_u64(const std::string& path, std::streamoff offset, uint64_t value)
+{
+	std::fstream out(path, std::ios::in | std::ios::out | std::ios::binary);
+	out.seekp(offset);
+	out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+constexpr std::streamoff kCountOffset = 16;
+constexpr std::streamoff kPayloadOffset = 24;
+}  // namespace
+
+TEST(BinaryIo, RejectsCorruptLengths)
+{
+	temp_file file("bmstu_binary_io_corrupt.bin");
+	bmstu::simple_vector<int> loaded;
+
+	// count * sizeof(int) переполняется и совпадает с payload_bytes.
+	bmstu::save_binary(file.path(), bmstu::simple_vector<int>{});
+	patch_u64(file.path(), kCountOffset, uint64_t{1} << 62);
+	ASSERT_THROW(bmstu::load_binary(file.path(), loaded), std::runtime_error);
+	ASSERT_THROW(bmstu::binary_view<int>(file.path()), std::runtime_error);
+
+	bmstu::save_binary(file.path(), bmstu::simple_vector<int>{1, 2});
+	patch_u64(file.path(), kCountOffset, uint64_t{1} << 60);
+	patch_u64(file.path(), kPayloadOffset, uint64_t{1} << 62);
+	ASSERT_THROW(bmstu::load_binary(file.path(), loaded), std::runtime_error);
+	ASSERT_THROW(bmstu::binary_view<int>(file.path()), std::runtime_error);
+
+	// Длины строк и вложенных векторов тоже берутся из файла.
+	bmstu::simple_vector<std::string> strings;
+	bmstu::save_binary(file.path(), bmstu::simple_vector<std::string>{"ab"});
+	patch_u64(file.path(), 64, uint64_t{1} << 60);
+	ASSERT_THROW(bmstu::load_binary(file.path(), strings), std::runtime_error);
+
+	bmstu::simple_vector<bmstu::simple_vector<std::string>> nested;
+	bmstu::save_binary(file.path(),
+					   bmstu::simple_vector<bmstu::simple_vector<std::string>>{
+						   bmstu::simple_vector<std::string>{"ab"}});
+	patch_u64(file.path(), 64, uint64_t{1} << 60);
+	ASSERT_THROW(bmstu::load_binary(file.path(), nested), std::runtime_error);
+
+	bmstu::save_binary(file.path(), bmstu::simple_vector<std::string>{"ab"});
+	patch_u64(file.path(), kCountOffset, uint64_t{1} << 60);
+	ASSERT_THROW(bmstu::load_binary(file.path(), strings), std::runtime_error);
+}
+
+namespace
+{
+template <typename F>
+double measure_s(F f)
+{
+	return bmstu::bench::measure_ms(f) / 1000;
+}
+}  // namespace
+
+TEST(BinaryIoBench, DISABLED_Throughput)
+{
+	constexpr size_t kCount = 50'000'000;
+	temp_file file("bmstu_binary_io_bench.bin");
+	bmstu::simple_vector<sample> v(kCount);
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		v[i] = {static_cast<int64_t>(i), i * 0.5};
+	}
+	const double gb = kCount * sizeof(sample) / 1e9;
+
+	const double save_s =
+		measure_s([&] { bmstu::save_binary(file.path(), v); });
+	bmstu::simple_vector<sample> loaded;
+	loaded.reserve(kCount);
+	const double load_s =
+		measure_s([&] { bmstu::load_binary(file.path(), loaded); });
+	int64_t sum = 0;
+	const double view_s = measure_s(
+		[&]
+		{
+			bmstu::binary_view<sample> view(file.path());
+			for (const sample& s : view)
+			{
+				sum += s.id;
+			}
+		});
+	ASSERT_EQ(sum, static_cast<int64_t>(kCount) * (kCount - 1) / 2);
+
+	temp_file text("bmstu_binary_io_bench.txt");
+	bmstu::simple_vector<int64_t> ids(kCount / 10);
+	std::iota(ids.begin(), ids.end(), 0);
+	const double text_s = measure_s(
+		[&]
+		{
+			std::ofstream out(text.path());
+			out << ids;
+		});
+
+	std::cout << "raw save " << gb / save_s << " GB/s, load into buffer "
+			  << gb / load_s << " GB/s, mmap view + scan " << gb / view_s
+			  << " GB/s\n";
+	const double text_gb = ids.size() * sizeof(int64_t) / 1e9;
+	std::cout << "text operator<< " << text_gb / text_s
+			  << " GB/s of int64 payload\n";
+}
@@ -0,0 +1,497 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Плотный вектор флагов: 64 флага в одном слове simple_vector<uint64_t>.
+// Хвост последнего слова всегда обнулён, поэтому count() и поиск работают
+// по целым словам. Пословные циклы (count, &=, |=, ^=) написаны так, чтобы
+// компилятор их векторизовал.
+class bit_vector
+{
+   public:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+	static constexpr size_t bits_per_word = 64;
+
+	// Прокси-ссылка на один бит.
+	class reference
+	{
+	   public:
+		reference(uint64_t* word, uint64_t mask) noexcept
+			: word_(word), mask_(mask)
+		{
+		}
+
+		reference(const reference& other) = default;
+
+		operator bool() const noexcept { return (*word_ & mask_) != 0; }
+
+		reference& operator=(bool value) noexcept
+		{
+			if (value)
+			{
+				*word_ |= mask_;
+			}
+			else
+			{
+				*word_ &= ~mask_;
+			}
+			return *this;
+		}
+
+		reference& operator=(const reference& other) noexcept
+		{
+			return *this = static_cast<bool>(other);
+		}
+
+		void flip() noexcept { *word_ ^= mask_; }
+
+		bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+	   private:
+		uint64_t* word_;
+		uint64_t mask_;
+	};
+
+	class const_iterator
+	{
+	   public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = bool;
+
+		const_iterator() = default;
+
+		const_iterator(const bit_vector* vec, size_t pos) noexcept
+			: vec_(vec), pos_(pos)
+		{
+		}
+
+		bool operator*() const noexcept { return (*vec_)[pos_]; }
+
+		bool operator[](difference_type n) const noexcept
+		{
+			return (*vec_)[pos_ + n];
+		}
+
+		const_iterator& operator++() noexcept
+		{
+			++pos_;
+			return *this;
+		}
+
+		const_iterator operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			++pos_;
+			return tmp;
+		}
+
+		const_iterator& operator--() noexcept
+		{
+			--pos_;
+			return *this;
+		}
+
+		const_iterator operator--(int) noexcept
+		{
+			const_iterator tmp = *this;
+			--pos_;
+			return tmp;
+		}
+
+		const_iterator& operator+=(difference_type n) noexcept
+		{
+			pos_ += n;
+			return *this;
+		}
+
+		const_iterator& operator-=(difference_type n) noexcept
+		{
+			pos_ -= n;
+			return *this;
+		}
+
+		friend const_iterator operator+(const_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend const_iterator operator-(const_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const const_iterator& lhs,
+										 const const_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.pos_) -
+				   static_cast<difference_type>(rhs.pos_);
+		}
+
+		friend bool operator==(const const_iterator& lhs,
+							   const const_iterator& rhs) noexcept
+		{
+			return lhs.pos_ == rhs.pos_;
+		}
+
+		friend auto operator<=>(const const_iterator& lhs,
+								const const_iterator& rhs) noexcept
+		{
+			return lhs.pos_ <=> rhs.pos_;
+		}
+
+	   private:
+		const bit_vector* vec_ = nullptr;
+		size_t pos_ = 0;
+	};
+
+	bit_vector() noexcept = default;
+
+	explicit bit_vector(size_t size, bool value = false)
+		: words_(words_for_(size), value ? ~uint64_t{0} : 0), size_(size)
+	{
+		clear_tail_();
+	}
+
+	bit_vector(std::initializer_list<bool> init)
+	{
+		reserve(init.size());
+		for (bool value : init)
+		{
+			push_back(value);
+		}
+	}
+
+	size_t size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	size_t capacity() const noexcept
+	{
+		return words_.capacity() * bits_per_word;
+	}
+
+	// Байты под сами флаги (без объекта вектора).
+	size_t memory_bytes() const noexcept
+	{
+		return words_.capacity() * sizeof(uint64_t);
+	}
+
+	const uint64_t* words() const noexcept { return words_.data(); }
+
+	size_t word_count() const noexcept { return words_.size(); }
+
+	bool operator[](size_t pos) const noexcept
+	{
+		return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1u;
+	}
+
+	reference operator[](size_t pos) noexcept
+	{
+		return reference(&words_[pos / bits_per_word],
+						 uint64_t{1} << (pos % bits_per_word));
+	}
+
+	bool test(size_t pos) const
+	{
+		check_(pos);
+		return (*this)[pos];
+	}
+
+	void set(size_t pos, bool value = true)
+	{
+		check_(pos);
+		(*this)[pos] = value;
+	}
+
+	void reset(size_t pos) { set(pos, false); }
+
+	void flip(size_t pos)
+	{
+		check_(pos);
+		(*this)[pos].flip();
+	}
+
+	void reserve(size_t bits) { words_.reserve(words_for_(bits)); }
+
+	void resize(size_t new_size, bool value = false)
+	{
+		const size_t old_size = size_;
+		words_.resize(words_for_(new_size));
+		size_ = new_size;
+		if (value && new_size > old_size)
+		{
+			set_range_(old_size, new_size);
+		}
+		clear_tail_();
+	}
+
+	void push_back(bool value)
+	{
+		if (size_ % bits_per_word == 0)
+		{
+			words_.push_back(0);
+		}
+		if (value)
+		{
+			words_[size_ / bits_per_word] |= uint64_t{1}
+											 << (size_ % bits_per_word);
+		}
+		++size_;
+	}
+
+	void pop_back() noexcept
+	{
+		if (size_ == 0)
+		{
+			return;
+		}
+		--size_;
+		if (size_ % bits_per_word == 0)
+		{
+			words_.pop_back();
+		}
+		else
+		{
+			clear_tail_();
+		}
+	}
+
+	void clear() noexcept
+	{
+		words_.clear();
+		size_ = 0;
+	}
+
+	// Число установленных битов.
+	size_t count() const noexcept
+	{
+		const uint64_t* w = words_.data();
+		const size_t n = words_.size();
+		size_t total = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			total += std::popcount(w[i]);
+		}
+		return total;
+	}
+
+	bool any() const noexcept { return find_first() != npos; }
+
+	bool none() const noexcept { return !any(); }
+
+	bool all() const noexcept { return count() == size_; }
+
+	size_t find_first() const noexcept { return find_from_word_(0); }
+
+	// Первый установленный бит строго после pos.
+	size_t find_next(size_t pos) const noexcept
+	{
+		++pos;
+		if (pos >= size_)
+		{
+			return npos;
+		}
+		const size_t w = pos / bits_per_word;
+		const uint64_t bits = words_[w] >> (pos % bits_per_word);
+		if (bits != 0)
+		{
+			return pos + std::countr_zero(bits);
+		}
+		return find_from_word_(w + 1);
+	}
+
+	// Вызывает f(pos) для каждого установленного бита по возрастанию.
+	template <typename F>
+	void for_each_set(F f) const
+	{
+		const uint64_t* w = words_.data();
+		const size_t n = words_.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			uint64_t bits = w[i];
+			while (bits != 0)
+			{
+				f(i * bits_per_word + std::countr_zero(bits));
+				bits &= bits - 1;
+			}
+		}
+	}
+
+	bit_vector& operator&=(const bit_vector& other)
+	{
+		check_same_size_(other);
+		uint64_t* dst = words_.data();
+		const uint64_t* src = other.words_.data();
+		const size_t n = words_.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			dst[i] &= src[i];
+		}
+		return *this;
+	}
+
+	bit_vector& operator|=(const bit_vector& other)
+	{
+		check_same_size_(other);
+		uint64_t* dst = words_.data();
+		const uint64_t* src = other.words_.data();
+		const size_t n = words_.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			dst[i] |= src[i];
+		}
+		return *this;
+	}
+
+	bit_vector& operator^=(const bit_vector& other)
+	{
+		check_same_size_(other);
+		uint64_t* dst = words_.data();
+		const uint64_t* src = other.words_.data();
+		const size_t n = words_.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			dst[i] ^= src[i];
+		}
+		return *this;
+	}
+
+	// Инвертирует все флаги.
+	bit_vector& flip() noexcept
+	{
+		uint64_t* dst = words_.data();
+		const size_t n = words_.size();
+		for (size_t i = 0; i < n; ++i)
+		{
+			dst[i] = ~dst[i];
+		}
+		clear_tail_();
+		return *this;
+	}
+
+	friend bit_vector operator&(bit_vector lhs, const bit_vector& rhs)
+	{
+		return lhs &= rhs;
+	}
+
+	friend bit_vector operator|(bit_vector lhs, const bit_vector& rhs)
+	{
+		return lhs |= rhs;
+	}
+
+	friend bit_vector operator^(bit_vector lhs, const bit_vector& rhs)
+	{
+		return lhs ^= rhs;
+	}
+
+	friend bit_vector operator~(bit_vector v) { return v.flip(); }
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+	void swap(bit_vector& other) noexcept
+	{
+		words_.swap(other.words_);
+		std::swap(size_, other.size_);
+	}
+
+	friend void swap(bit_vector& lhs, bit_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+	friend bool operator==(const bit_vector& lhs, const bit_vector& rhs)
+	{
+		return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const bit_vector& v)
+	{
+		for (size_t i = 0; i < v.size_; ++i)
+		{
+			os << (v[i] ? '1' : '0');
+		}
+		return os;
+	}
+
+   private:
+	static size_t words_for_(size_t bits) noexcept
+	{
+		return (bits + bits_per_word - 1) / bits_per_word;
+	}
+
+	void check_(size_t pos) const
+	{
+		if (pos >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+	}
+
+	void check_same_size_(const bit_vector& other) const
+	{
+		if (other.size_ != size_)
+		{
+			throw std::invalid_argument("bit_vector sizes differ");
+		}
+	}
+
+	void clear_tail_() noexcept
+	{
+		const size_t used = size_ % bits_per_word;
+		if (used != 0)
+		{
+			words_[words_.size() - 1] &= (uint64_t{1} << used) - 1;
+		}
+	}
+
+	void set_range_(size_t first, size_t last) noexcept
+	{
+		for (; first < last && first % bits_per_word != 0; ++first)
+		{
+			(*this)[first] = true;
+		}
+		for (; first + bits_per_word <= last; first += bits_per_word)
+		{
+			words_[first / bits_per_word] = ~uint64_t{0};
+		}
+		for (; first < last; ++first)
+		{
+			(*this)[first] = true;
+		}
+	}
+
+	size_t find_from_word_(size_t w) const noexcept
+	{
+		const uint64_t* words = words_.data();
+		const size_t n = words_.size();
+		for (; w < n; ++w)
+		{
+			if (words[w] != 0)
+			{
+				return w * bits_per_word + std::countr_zero(words[w]);
+			}
+		}
+		return npos;
+	}
+
+	simple_vector<uint64_t> words_;
+	size_t size_ = 0;
+};
+}  // namespace bmstu
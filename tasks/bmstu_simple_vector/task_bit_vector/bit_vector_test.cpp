@@ -0,0 +1,193 @@
+#include "bit_vector.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "bench.h"
+#include "bmstu_simple_vector.h"
+
+TEST(BitVector, DefaultConstructor)
+{
+	bmstu::bit_vector v;
+	ASSERT_EQ(v.size(), 0u);
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.count(), 0u);
+	ASSERT_EQ(v.find_first(), bmstu::bit_vector::npos);
+	ASSERT_EQ(v.begin(), v.end());
+}
+
+TEST(BitVector, SizeValueConstructor)
+{
+	bmstu::bit_vector v(130, true);
+	ASSERT_EQ(v.size(), 130u);
+	ASSERT_EQ(v.word_count(), 3u);
+	ASSERT_EQ(v.count(), 130u);
+	ASSERT_TRUE(v.all());
+	// Хвост последнего слова не должен попадать в count().
+	ASSERT_EQ(v.words()[2], 0b11u);
+}
+
+TEST(BitVector, ProxyReference)
+{
+	bmstu::bit_vector v(100);
+	v[3] = true;
+	v[64] = true;
+	v[99] = v[3];
+	ASSERT_TRUE(v[3]);
+	ASSERT_FALSE(v[4]);
+	ASSERT_TRUE(v[64]);
+	ASSERT_TRUE(v[99]);
+	v[3].flip();
+	ASSERT_FALSE(v[3]);
+	ASSERT_TRUE(~v[3]);
+	ASSERT_EQ(v.count(), 2u);
+
+	const bmstu::bit_vector& cv = v;
+	ASSERT_TRUE(cv[64]);
+	ASSERT_TRUE(v.test(99));
+	ASSERT_THROW(v.test(100), std::out_of_range);
+	ASSERT_THROW(v.set(100), std::out_of_range);
+}
+
+TEST(BitVector, PushPopResize)
+{
+	bmstu::bit_vector v;
+	for (int i = 0; i < 200; ++i)
+	{
+		v.push_back(i % 3 == 0);
+	}
+	ASSERT_EQ(v.size(), 200u);
+	ASSERT_EQ(v.count(), 67u);
+	for (int i = 0; i < 200; ++i)
+	{
+		ASSERT_EQ(v[i], i % 3 == 0);
+	}
+	while (v.size() > 64)
+	{
+		v.pop_back();
+	}
+	ASSERT_EQ(v.word_count(), 1u);
+	ASSERT_EQ(v.count(), 22u);
+
+	v.resize(150, true);
+	ASSERT_EQ(v.count(), 22u + 86u);
+	ASSERT_TRUE(v[149]);
+	v.resize(70);
+	ASSERT_EQ(v.count(), 22u + 6u);
+	v.resize(150);
+	ASSERT_FALSE(v[100]);
+	ASSERT_EQ(v.count(), 28u);
+}
+
+TEST(BitVector, InitializerListAndOutput)
+{
+	bmstu::bit_vector v{true, false, true, true};
+	std::ostringstream os;
+	os << v;
+	ASSERT_EQ(os.str(), "1011");
+	ASSERT_EQ(std::count(v.begin(), v.end(), true), 3);
+	ASSERT_EQ(v.end() - v.begin(), 4);
+}
+
+TEST(BitVector, FindFirstAndNext)
+{
+	bmstu::bit_vector v(1000);
+	const std::vector<size_t> positions{5, 63, 64, 65, 500, 999};
+	for (size_t pos : positions)
+	{
+		v.set(pos);
+	}
+	std::vector<size_t> found;
+	for (size_t pos = v.find_first(); pos != bmstu::bit_vector::npos;
+		 pos = v.find_next(pos))
+	{
+		found.push_back(pos);
+	}
+	ASSERT_EQ(found, positions);
+
+	found.clear();
+	v.for_each_set([&found](size_t pos) { found.push_back(pos); });
+	ASSERT_EQ(found, positions);
+	ASSERT_EQ(v.find_next(999), bmstu::bit_vector::npos);
+}
+
+TEST(BitVector, BulkOperations)
+{
+	bmstu::bit_vector a{true, true, false, false};
+	bmstu::bit_vector b{true, false, true, false};
+	ASSERT_EQ(a & b, (bmstu::bit_vector{true, false, false, false}));
+	ASSERT_EQ(a | b, (bmstu::bit_vector{true, true, true, false}));
+	ASSERT_EQ(a ^ b, (bmstu::bit_vector{false, true, true, false}));
+	ASSERT_EQ(~a, (bmstu::bit_vector{false, false, true, true}));
+	ASSERT_EQ((~a).count(), 2u);
+	ASSERT_THROW(a &= bmstu::bit_vector(5), std::invalid_argument);
+}
+
+TEST(BitVector, MemoryFootprint)
+{
+	constexpr size_t kFlags = 1 << 20;
+	bmstu::bit_vector bits(kFlags);
+	bmstu::simple_vector<bool> bytes(kFlags);
+	ASSERT_EQ(bits.memory_bytes() * 8, bytes.capacity() * sizeof(bool));
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(BitVectorBench, DISABLED_CountAndScan)
+{
+	constexpr size_t kFlags = 1'000'000'000;
+	bmstu::bit_vector bits(kFlags);
+	bmstu::simple_vector<bool> bytes(kFlags);
+	std::mt19937_64 gen(1);
+	for (size_t i = 0; i < kFlags / 1000; ++i)
+	{
+		const size_t pos = gen() % kFlags;
+		bits[pos] = true;
+		bytes[pos] = true;
+	}
+	std::cout << "memory: bit_vector " << bits.memory_bytes() / (1 << 20)
+			  << " MiB, simple_vector<bool> "
+			  << bytes.capacity() * sizeof(bool) / (1 << 20) << " MiB\n";
+
+	size_t bits_count = 0;
+	size_t bytes_count = 0;
+	std::cout << "count: bit_vector "
+			  << measure_ms([&] { bits_count = bits.count(); })
+			  << " ms, simple_vector<bool> "
+			  << measure_ms(
+					 [&]
+					 {
+						 bytes_count = std::count(bytes.begin(), bytes.end(),
+												  true);
+					 })
+			  << " ms\n";
+	ASSERT_EQ(bits_count, bytes_count);
+
+	size_t bits_seen = 0;
+	size_t bytes_seen = 0;
+	std::cout << "scan set: bit_vector "
+			  << measure_ms(
+					 [&] { bits.for_each_set([&](size_t) { ++bits_seen; }); })
+			  << " ms, simple_vector<bool> "
+			  << measure_ms(
+					 [&]
+					 {
+						 for (auto it = std::find(bytes.begin(), bytes.end(),
+												  true);
+							  it != bytes.end();
+							  it = std::find(it + 1, bytes.end(), true))
+						 {
+							 ++bytes_seen;
+						 }
+					 })
+			  << " ms\n";
+	ASSERT_EQ(bits_seen, bytes_seen);
+
+	bmstu::bit_vector mask(kFlags, true);
+	std::cout << "and: bit_vector " << measure_ms([&] { bits &= mask; })
+			  << " ms\n";
+}
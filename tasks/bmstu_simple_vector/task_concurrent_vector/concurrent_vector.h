@@ -0,0 +1,354 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace bmstu
+{
+// Растущий вектор для параллельных добавлений без мьютекса.
+//
+// Элементы лежат в корзинах размером 32, 64, 128, ... — корзина выделяется
+// один раз и никогда не перемещается, поэтому адреса элементов стабильны.
+// push_back резервирует слот через CAS, заполняет его и ставит флаг
+// готовности; других потоков он не ждёт. Счётчик size() сдвигается только
+// по непрерывному префиксу готовых слотов, так что читатель может обходить
+// [0, size()) параллельно с писателями.
+template <typename T>
+class concurrent_vector
+{
+	static constexpr size_t kFirstBucketBits = 5;
+	static constexpr size_t kBucketCount = 64 - kFirstBucketBits;
+
+	struct slot
+	{
+		std::atomic<bool> ready{false};
+		T value{};
+	};
+
+	template <bool Const>
+	class basic_iterator
+	{
+		using owner = std::conditional_t<Const, const concurrent_vector,
+										 concurrent_vector>;
+
+	   public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() = default;
+
+		basic_iterator(owner* vec, size_t index) noexcept
+			: vec_(vec), index_(index)
+		{
+		}
+
+		reference operator*() const noexcept { return (*vec_)[index_]; }
+
+		pointer operator->() const noexcept { return &(*vec_)[index_]; }
+
+		reference operator[](difference_type n) const noexcept
+		{
+			return (*vec_)[index_ + n];
+		}
+
+		basic_iterator& operator++() noexcept
+		{
+			++index_;
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			--index_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			index_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			index_ -= n;
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.index_) -
+				   static_cast<difference_type>(rhs.index_);
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ == rhs.index_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ <=> rhs.index_;
+		}
+
+	   private:
+		owner* vec_ = nullptr;
+		size_t index_ = 0;
+	};
+
+   public:
+	using value_type = T;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	concurrent_vector() = default;
+
+	concurrent_vector(const concurrent_vector& other) = delete;
+	concurrent_vector& operator=(const concurrent_vector& other) = delete;
+
+	~concurrent_vector()
+	{
+		for (auto& bucket : buckets_)
+		{
+			delete[] bucket.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Потокобезопасно. Возвращает индекс добавленного элемента; элемент
+	// доступен вызвавшему потоку сразу, остальным — когда size() его покроет.
+	size_t push_back(const T& value)
+	{
+		T tmp = value;
+		return push_back(std::move(tmp));
+	}
+
+	size_t push_back(T&& value)
+	{
+		size_t index = 0;
+		slot& s = claim_slot_(index);
+		s.value = std::move(value);
+		s.ready.store(true, std::memory_order_seq_cst);
+		publish_(index);
+		return index;
+	}
+
+	// Число опубликованных элементов: все слоты [0, size()) заполнены.
+	size_t size() const noexcept
+	{
+		return published_.load(std::memory_order_acquire);
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+
+	T& operator[](size_t index) noexcept { return slot_(index).value; }
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return slot_(index).value;
+	}
+
+	T& at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	// Итераторы фиксируют size() в момент вызова end().
+	iterator begin() noexcept { return iterator(this, 0); }
+
+	iterator end() noexcept { return iterator(this, size()); }
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, size());
+	}
+
+	// Не потокобезопасно: корзины остаются выделенными.
+	void clear() noexcept
+	{
+		const size_t n = reserved_.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < n; ++i)
+		{
+			slot_(i).ready.store(false, std::memory_order_relaxed);
+		}
+		reserved_.store(0, std::memory_order_relaxed);
+		published_.store(0, std::memory_order_relaxed);
+	}
+
+   private:
+	static_assert(std::is_nothrow_move_assignable_v<T>,
+				  "a claimed slot must be filled without throwing");
+
+	static size_t bucket_of_(size_t index, size_t& offset) noexcept
+	{
+		const size_t pos = index + (size_t{1} << kFirstBucketBits);
+		const size_t bucket = std::bit_width(pos >> kFirstBucketBits) - 1;
+		offset = pos - (size_t{1} << (bucket + kFirstBucketBits));
+		return bucket;
+	}
+
+	slot& slot_(size_t index) const noexcept
+	{
+		size_t offset = 0;
+		const size_t b = bucket_of_(index, offset);
+		return buckets_[b].load(std::memory_order_acquire)[offset];
+	}
+
+	// Слот занимается CAS по reserved_ только после того, как его корзина
+	// выделена. Занятый слот обязан стать готовым, иначе size() навсегда
+	// остановится на нём; исключение из выделения корзины вылетает до
+	// захвата, а перемещение в слот не бросает.
+	//
+	// Корзину ставит через CAS любой писатель, не нашедший её на месте;
+	// проигравший освобождает свою копию. Чтобы копии были редкостью,
+	// писатель, занявший первый слот корзины, заранее выделяет следующую:
+	// он такой один, и к моменту, когда до неё дойдут, она обычно уже есть.
+	slot& claim_slot_(size_t& index)
+	{
+		index = reserved_.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			size_t offset = 0;
+			const size_t b = bucket_of_(index, offset);
+			slot* bucket = allocate_bucket_(b);
+			if (reserved_.compare_exchange_weak(index, index + 1,
+												std::memory_order_relaxed))
+			{
+				if (offset == 0 && b + 1 < kBucketCount)
+				{
+					prefetch_bucket_(b + 1);
+				}
+				return bucket[offset];
+			}
+		}
+	}
+
+	// Неудачная подготовка не ошибка: корзину выделит тот, кому она
+	// понадобится.
+	void prefetch_bucket_(size_t b) noexcept
+	{
+		try
+		{
+			allocate_bucket_(b);
+		}
+		catch (...)
+		{
+		}
+	}
+
+	slot* allocate_bucket_(size_t b)
+	{
+		slot* bucket = buckets_[b].load(std::memory_order_acquire);
+		if (bucket != nullptr)
+		{
+			return bucket;
+		}
+		slot* fresh = new slot[size_t{1} << (b + kFirstBucketBits)];
+		if (buckets_[b].compare_exchange_strong(bucket, fresh,
+												std::memory_order_acq_rel,
+												std::memory_order_acquire))
+		{
+			return fresh;
+		}
+		delete[] fresh;
+		return bucket;
+	}
+
+	// Сдвигает published_ по готовым слотам. Двигает счётчик только писатель,
+	// чей слот стоит на границе опубликованного префикса; после каждого
+	// сдвига он перепроверяет новую границу, так что слот, дописанный во
+	// время прохода, не потеряется, а отставшие писатели не сканируют хвост
+	// заново.
+	void publish_(size_t index) noexcept
+	{
+		size_t p = published_.load(std::memory_order_seq_cst);
+		if (p != index)
+		{
+			return;
+		}
+		for (;;)
+		{
+			const size_t reserved = reserved_.load(std::memory_order_seq_cst);
+			size_t q = p;
+			while (q < reserved && ready_(q))
+			{
+				++q;
+			}
+			if (q == p)
+			{
+				return;
+			}
+			if (published_.compare_exchange_strong(p, q,
+												   std::memory_order_seq_cst))
+			{
+				p = q;
+			}
+		}
+	}
+
+	// Слот может быть зарезервирован раньше, чем выделена его корзина.
+	bool ready_(size_t index) const noexcept
+	{
+		size_t offset = 0;
+		const size_t b = bucket_of_(index, offset);
+		const slot* bucket = buckets_[b].load(std::memory_order_acquire);
+		return bucket != nullptr &&
+			   bucket[offset].ready.load(std::memory_order_seq_cst);
+	}
+
+	std::atomic<slot*> buckets_[kBucketCount] = {};
+	std::atomic<size_t> reserved_{0};
+	std::atomic<size_t> published_{0};
+};
+}  // namespace bmstu
@@ -0,0 +1,240 @@
+#include "concurrent_vector.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+TEST(ConcurrentVector, DefaultConstructor)
+{
+	bmstu::concurrent_vector<int> v;
+	ASSERT_EQ(v.size(), 0u);
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.begin(), v.end());
+}
+
+TEST(ConcurrentVector, PushBackSingleThread)
+{
+	bmstu::concurrent_vector<std::string> v;
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(v.push_back(std::to_string(i)), static_cast<size_t>(i));
+	}
+	ASSERT_EQ(v.size(), 1000u);
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(v[i], std::to_string(i));
+	}
+	ASSERT_EQ(v.at(999), "999");
+	ASSERT_THROW(v.at(1000), std::out_of_range);
+	ASSERT_EQ(std::distance(v.begin(), v.end()), 1000);
+}
+
+TEST(ConcurrentVector, StableAddresses)
+{
+	bmstu::concurrent_vector<int> v;
+	v.push_back(42);
+	const int* first = &v[0];
+	for (int i = 0; i < 100000; ++i)
+	{
+		v.push_back(i);
+	}
+	ASSERT_EQ(first, &v[0]);
+	ASSERT_EQ(*first, 42);
+}
+
+TEST(ConcurrentVector, ParallelPushBack)
+{
+	constexpr int kThreads = 8;
+	constexpr int kPerThread = 20000;
+	bmstu::concurrent_vector<int> v;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads; ++t)
+	{
+		threads.emplace_back(
+			[&v, t]
+			{
+				for (int i = 0; i < kPerThread; ++i)
+				{
+					v.push_back(t * kPerThread + i);
+				}
+			});
+	}
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+	ASSERT_EQ(v.size(), static_cast<size_t>(kThreads * kPerThread));
+	std::vector<int> values(v.begin(), v.end());
+	std::sort(values.begin(), values.end());
+	for (int i = 0; i < kThreads * kPerThread; ++i)
+	{
+		ASSERT_EQ(values[i], i);
+	}
+}
+
+TEST(ConcurrentVector, ReadWhileAppending)
+{
+	struct pair
+	{
+		int a = 0;
+		int b = 0;
+	};
+	constexpr int kWriters = 4;
+	constexpr int kPerThread = 20000;
+	bmstu::concurrent_vector<pair> v;
+	std::atomic<bool> done{false};
+	std::atomic<bool> torn{false};
+
+	std::thread reader(
+		[&]
+		{
+			while (!done.load())
+			{
+				for (const pair& p : v)
+				{
+					if (p.a != -p.b || p.a == 0)
+					{
+						torn = true;
+					}
+				}
+			}
+		});
+	std::vector<std::thread> writers;
+	for (int t = 0; t < kWriters; ++t)
+	{
+		writers.emplace_back(
+			[&v, t]
+			{
+				for (int i = 1; i <= kPerThread; ++i)
+				{
+					const int x = t * kPerThread + i;
+					v.push_back(pair{x, -x});
+				}
+			});
+	}
+	for (auto& th : writers)
+	{
+		th.join();
+	}
+	done = true;
+	reader.join();
+	ASSERT_FALSE(torn.load());
+	ASSERT_EQ(v.size(), static_cast<size_t>(kWriters * kPerThread));
+}
+
+TEST(ConcurrentVector, Clear)
+{
+	bmstu::concurrent_vector<int> v;
+	v.push_back(1);
+	v.push_back(2);
+	v.clear();
+	ASSERT_TRUE(v.empty());
+	v.push_back(3);
+	ASSERT_EQ(v.size(), 1u);
+	ASSERT_EQ(v[0], 3);
+}
+
+namespace
+{
+// Конструктор по умолчанию бросает по требованию: так корзина, которая
+// строит свои слоты, не выделяется.
+struct flaky
+{
+	static inline bool fail = false;
+
+	flaky()
+	{
+		if (fail)
+		{
+			throw std::runtime_error("bucket allocation failed");
+		}
+	}
+
+	explicit flaky(int v) : value(v) {}
+
+	int value = 0;
+};
+}  // namespace
+
+TEST(ConcurrentVector, FailedBucketAllocationKeepsPublishing)
+{
+	bmstu::concurrent_vector<flaky> v;
+	for (int i = 0; i < 32; ++i)
+	{
+		v.push_back(flaky(i));
+	}
+	// Вторая корзина (32..95) уже выделена заранее, третья — нет.
+	flaky::fail = true;
+	for (int i = 32; i < 96; ++i)
+	{
+		v.push_back(flaky(i));
+	}
+	ASSERT_THROW(v.push_back(flaky(96)), std::runtime_error);
+	ASSERT_EQ(v.size(), 96u);
+	flaky::fail = false;
+	ASSERT_EQ(v.push_back(flaky(96)), 96u);
+	ASSERT_EQ(v.size(), 97u);
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		ASSERT_EQ(v[i].value, static_cast<int>(i));
+	}
+}
+
+namespace
+{
+template <typename Push>
+double run_threads(int threads, size_t total, Push push)
+{
+	std::vector<std::thread> pool;
+	const auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t)
+	{
+		pool.emplace_back(
+			[&, t]
+			{
+				for (size_t i = t; i < total; i += threads)
+				{
+					push(static_cast<int>(i));
+				}
+			});
+	}
+	for (auto& th : pool)
+	{
+		th.join();
+	}
+	const std::chrono::duration<double> elapsed =
+		std::chrono::steady_clock::now() - start;
+	return total / elapsed.count() / 1e6;
+}
+}  // namespace
+
+TEST(ConcurrentVectorBench, DISABLED_AppendScaling)
+{
+	constexpr size_t kTotal = 20'000'000;
+	for (int threads = 1; threads <= 64; threads *= 2)
+	{
+		bmstu::concurrent_vector<int> lock_free;
+		const double lock_free_rate = run_threads(
+			threads, kTotal, [&](int x) { lock_free.push_back(x); });
+
+		std::mutex mutex;
+		bmstu::simple_vector<int> locked;
+		const double locked_rate = run_threads(threads, kTotal,
+											   [&](int x)
+											   {
+												   std::lock_guard lock(mutex);
+												   locked.push_back(x);
+											   });
+		std::cout << threads << " threads: concurrent_vector "
+				  << lock_free_rate << " M/s, mutex + simple_vector "
+				  << locked_rate << " M/s\n";
+	}
+}
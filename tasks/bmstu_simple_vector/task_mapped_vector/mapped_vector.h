@@ -0,0 +1,319 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace bmstu
+{
+// Вектор тривиально копируемых записей, живущий прямо в файле.
+// Файл: заголовок на 64 байта, за ним сырой массив T. Повторное открытие
+// сводится к mmap и проверке заголовка, без поэлементной десериализации.
+template <typename T>
+class mapped_vector
+{
+	static_assert(std::is_trivially_copyable_v<T>,
+				  "mapped_vector stores raw bytes of T");
+	static_assert(alignof(T) <= 64, "mapped_vector supports alignof(T) <= 64");
+
+   public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	explicit mapped_vector(const std::string& path)
+	{
+		fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+		if (fd_ < 0)
+		{
+			throw_errno("open");
+		}
+		struct stat st = {};
+		if (::fstat(fd_, &st) != 0)
+		{
+			close_();
+			throw_errno("fstat");
+		}
+		if (st.st_size == 0)
+		{
+			try
+			{
+				truncate_(kDataOffset);
+				map_(kDataOffset);
+			}
+			catch (...)
+			{
+				close_();
+				throw;
+			}
+			header_()->magic = kMagic;
+			header_()->elem_size = sizeof(T);
+			header_()->size = 0;
+			header_()->capacity = 0;
+			return;
+		}
+		if (static_cast<size_t>(st.st_size) < kDataOffset)
+		{
+			close_();
+			throw std::runtime_error("mapped_vector: file is too small");
+		}
+		map_(static_cast<size_t>(st.st_size));
+		// Ёмкость сравнивается делением, чтобы испорченное поле не
+		// переполнило bytes_for_.
+		if (header_()->magic != kMagic || header_()->elem_size != sizeof(T) ||
+			header_()->capacity > (mapped_bytes_ - kDataOffset) / sizeof(T) ||
+			header_()->size > header_()->capacity)
+		{
+			unmap_();
+			close_();
+			throw std::runtime_error("mapped_vector: incompatible file");
+		}
+	}
+
+	mapped_vector(const mapped_vector& other) = delete;
+	mapped_vector& operator=(const mapped_vector& other) = delete;
+
+	mapped_vector(mapped_vector&& other) noexcept { swap(other); }
+
+	mapped_vector& operator=(mapped_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			mapped_vector tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~mapped_vector()
+	{
+		unmap_();
+		close_();
+	}
+
+	size_t size() const noexcept { return base_ ? header_()->size : 0; }
+
+	size_t capacity() const noexcept
+	{
+		return base_ ? header_()->capacity : 0;
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+
+	T* data() noexcept { return data_(); }
+
+	const T* data() const noexcept { return data_(); }
+
+	iterator begin() noexcept { return data_(); }
+
+	iterator end() noexcept { return data_() + size(); }
+
+	const_iterator begin() const noexcept { return data_(); }
+
+	const_iterator end() const noexcept { return data_() + size(); }
+
+	T& operator[](size_t index) noexcept { return data_()[index]; }
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return data_()[index];
+	}
+
+	T& at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_()[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_()[index];
+	}
+
+	void reserve(size_t new_cap)
+	{
+		if (new_cap <= capacity())
+		{
+			return;
+		}
+		const size_t new_bytes = bytes_for_(new_cap);
+		truncate_(new_bytes);
+		remap_(new_bytes);
+		header_()->capacity = new_cap;
+	}
+
+	void resize(size_t new_size)
+	{
+		if (new_size > capacity())
+		{
+			reserve(new_size);
+		}
+		for (size_t i = size(); i < new_size; ++i)
+		{
+			data_()[i] = T{};
+		}
+		header_()->size = new_size;
+	}
+
+	void push_back(const T& value)
+	{
+		// value может лежать в самом отображении, которое reserve переносит.
+		const T copy = value;
+		const size_t n = size();
+		if (n == capacity())
+		{
+			reserve(n == 0 ? kInitialCapacity : n * 2);
+		}
+		data_()[n] = copy;
+		header_()->size = n + 1;
+	}
+
+	void pop_back() noexcept { --header_()->size; }
+
+	void clear() noexcept { header_()->size = 0; }
+
+	// Сбросить грязные страницы на диск. Без вызова данные всё равно попадут в
+	// файл, но ядро решает само, когда.
+	void sync()
+	{
+		if (base_ && ::msync(base_, mapped_bytes_, MS_SYNC) != 0)
+		{
+			throw_errno("msync");
+		}
+	}
+
+	void swap(mapped_vector& other) noexcept
+	{
+		std::swap(fd_, other.fd_);
+		std::swap(base_, other.base_);
+		std::swap(mapped_bytes_, other.mapped_bytes_);
+	}
+
+	friend void swap(mapped_vector& lhs, mapped_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+   private:
+	struct file_header
+	{
+		uint64_t magic;
+		uint64_t elem_size;
+		uint64_t size;
+		uint64_t capacity;
+	};
+
+	static constexpr uint64_t kMagic = 0x31564d5554534d42ull;  // "BMSTUMV1"
+	static constexpr size_t kDataOffset = 64;
+	static constexpr size_t kInitialCapacity = 16;
+
+	static_assert(sizeof(file_header) <= kDataOffset);
+
+	static size_t bytes_for_(size_t cap) noexcept
+	{
+		return kDataOffset + cap * sizeof(T);
+	}
+
+	[[noreturn]] static void throw_errno(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(),
+								std::string("mapped_vector: ") + what);
+	}
+
+	file_header* header_() const noexcept
+	{
+		return static_cast<file_header*>(base_);
+	}
+
+	T* data_() const noexcept
+	{
+		return base_ ? reinterpret_cast<T*>(static_cast<char*>(base_) +
+											kDataOffset)
+					 : nullptr;
+	}
+
+	void truncate_(size_t bytes)
+	{
+		if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+		{
+			throw_errno("ftruncate");
+		}
+	}
+
+	void map_(size_t bytes)
+	{
+		void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+						 fd_, 0);
+		if (p == MAP_FAILED)
+		{
+			const int err = errno;
+			close_();
+			errno = err;
+			throw_errno("mmap");
+		}
+		base_ = p;
+		mapped_bytes_ = bytes;
+	}
+
+	void remap_(size_t bytes)
+	{
+#ifdef __linux__
+		void* p = ::mremap(base_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+		if (p == MAP_FAILED)
+		{
+			throw_errno("mremap");
+		}
+#else
+		void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+						 fd_, 0);
+		if (p == MAP_FAILED)
+		{
+			throw_errno("mmap");
+		}
+		::munmap(base_, mapped_bytes_);
+#endif
+		base_ = p;
+		mapped_bytes_ = bytes;
+	}
+
+	void unmap_() noexcept
+	{
+		if (base_ != nullptr)
+		{
+			::munmap(base_, mapped_bytes_);
+			base_ = nullptr;
+			mapped_bytes_ = 0;
+		}
+	}
+
+	void close_() noexcept
+	{
+		if (fd_ >= 0)
+		{
+			::close(fd_);
+			fd_ = -1;
+		}
+	}
+
+	int fd_ = -1;
+	void* base_ = nullptr;
+	size_t mapped_bytes_ = 0;
+};
+}  // namespace bmstu
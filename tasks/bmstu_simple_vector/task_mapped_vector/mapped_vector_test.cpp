@@ -0,0 +1,235 @@
+#include "mapped_vector.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+struct record
+{
+	int64_t id;
+	double value;
+};
+
+class temp_file
+{
+   public:
+	explicit temp_file(const char* name)
+		: path_((std::filesystem::temp_directory_path() / name).string())
+	{
+		std::filesystem::remove(path_);
+	}
+
+	~temp_file() { std::filesystem::remove(path_); }
+
+	const std::string& path() const { return path_; }
+
+   private:
+	std::string path_;
+};
+}  // namespace
+
+TEST(MappedVector, CreateEmpty)
+{
+	temp_file file("bmstu_mapped_vector_create.bin");
+	bmstu::mapped_vector<record> v(file.path());
+	ASSERT_EQ(v.size(), 0u);
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.capacity(), 0u);
+	ASSERT_EQ(v.begin(), v.end());
+}
+
+TEST(MappedVector, PushBackGrows)
+{
+	temp_file file("bmstu_mapped_vector_push.bin");
+	bmstu::mapped_vector<record> v(file.path());
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		v.push_back({i, i * 0.5});
+	}
+	ASSERT_EQ(v.size(), 1000u);
+	ASSERT_GE(v.capacity(), v.size());
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(v[i].id, i);
+		ASSERT_EQ(v[i].value, i * 0.5);
+	}
+}
+
+TEST(MappedVector, Reopen)
+{
+	temp_file file("bmstu_mapped_vector_reopen.bin");
+	{
+		bmstu::mapped_vector<record> v(file.path());
+		for (int64_t i = 0; i < 100; ++i)
+		{
+			v.push_back({i, -1.0 * i});
+		}
+		v.pop_back();
+	}
+	bmstu::mapped_vector<record> v(file.path());
+	ASSERT_EQ(v.size(), 99u);
+	ASSERT_EQ(v[98].id, 98);
+	ASSERT_EQ(v[98].value, -98.0);
+	v.push_back({1000, 1.0});
+	ASSERT_EQ(v.size(), 100u);
+	ASSERT_EQ(v[99].id, 1000);
+}
+
+TEST(MappedVector, PushBackOwnElement)
+{
+	temp_file file("bmstu_mapped_vector_self.bin");
+	bmstu::mapped_vector<record> v(file.path());
+	v.push_back({42, 0.5});
+	while (v.size() < v.capacity())
+	{
+		v.push_back(v[0]);
+	}
+	// Рост перемещает отображение, а value ссылается в старое.
+	v.push_back(v[0]);
+	for (const record& r : v)
+	{
+		ASSERT_EQ(r.id, 42);
+		ASSERT_EQ(r.value, 0.5);
+	}
+}
+
+TEST(MappedVector, ResizeAndClear)
+{
+	temp_file file("bmstu_mapped_vector_resize.bin");
+	bmstu::mapped_vector<int> v(file.path());
+	v.resize(10);
+	ASSERT_EQ(v.size(), 10u);
+	for (int x : v)
+	{
+		ASSERT_EQ(x, 0);
+	}
+	v[3] = 42;
+	v.resize(2);
+	v.resize(5);
+	ASSERT_EQ(v[3], 0);
+	const size_t old_capacity = v.capacity();
+	v.clear();
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.capacity(), old_capacity);
+}
+
+TEST(MappedVector, At)
+{
+	temp_file file("bmstu_mapped_vector_at.bin");
+	bmstu::mapped_vector<int> v(file.path());
+	v.resize(3);
+	ASSERT_EQ(&v.at(2), &v[2]);
+	try
+	{
+		v.at(3);
+		FAIL();
+	}
+	catch (std::out_of_range const& err)
+	{
+		EXPECT_EQ(err.what(), std::string("Index out of range"));
+	}
+}
+
+TEST(MappedVector, RejectsOtherElementType)
+{
+	temp_file file("bmstu_mapped_vector_type.bin");
+	{
+		bmstu::mapped_vector<record> v(file.path());
+		v.push_back({1, 1.0});
+	}
+	ASSERT_THROW(bmstu::mapped_vector<int> v(file.path()), std::runtime_error);
+}
+
+TEST(MappedVector, RejectsCorruptHeader)
+{
+	temp_file file("bmstu_mapped_vector_corrupt.bin");
+	{
+		bmstu::mapped_vector<int> v(file.path());
+		v.push_back(1);
+	}
+	{
+		// Поле size лежит третьим словом заголовка.
+		std::fstream out(file.path(),
+						 std::ios::in | std::ios::out | std::ios::binary);
+		const uint64_t size = 1'000'000;
+		out.seekp(2 * sizeof(uint64_t));
+		out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	}
+	ASSERT_THROW(bmstu::mapped_vector<int> v(file.path()), std::runtime_error);
+}
+
+TEST(MappedVector, Move)
+{
+	temp_file file("bmstu_mapped_vector_move.bin");
+	bmstu::mapped_vector<int> v(file.path());
+	v.push_back(7);
+	bmstu::mapped_vector<int> moved(std::move(v));
+	ASSERT_EQ(moved.size(), 1u);
+	ASSERT_EQ(moved[0], 7);
+	ASSERT_EQ(v.size(), 0u);
+}
+
+// Бенчмарки запускаются вручную:
+// ./bmstu_simple_vector --gtest_also_run_disabled_tests
+// --gtest_filter='MappedVectorBench.*'
+TEST(MappedVectorBench, DISABLED_RestartLatency)
+{
+	constexpr int64_t kCount = 10'000'000;
+	temp_file mapped("bmstu_mapped_vector_bench.bin");
+	temp_file stream("bmstu_mapped_vector_bench_stream.bin");
+	{
+		bmstu::mapped_vector<record> v(mapped.path());
+		std::ofstream out(stream.path(), std::ios::binary);
+		for (int64_t i = 0; i < kCount; ++i)
+		{
+			const record r{i, static_cast<double>(i)};
+			v.push_back(r);
+			out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<record> loaded;
+	{
+		std::ifstream in(stream.path(), std::ios::binary);
+		record r{};
+		while (in.read(reinterpret_cast<char*>(&r), sizeof(r)))
+		{
+			loaded.push_back(r);
+		}
+	}
+	const auto stream_time = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	bmstu::mapped_vector<record> reopened(mapped.path());
+	const auto reopen_time = std::chrono::steady_clock::now() - start;
+
+	ASSERT_EQ(loaded.size(), reopened.size());
+	std::cout << "element-wise load: "
+			  << std::chrono::duration<double, std::milli>(stream_time).count()
+			  << " ms, mapped reopen: "
+			  << std::chrono::duration<double, std::micro>(reopen_time).count()
+			  << " us\n";
+}
+
+TEST(MappedVectorBench, DISABLED_AppendThroughput)
+{
+	constexpr int64_t kCount = 50'000'000;
+	temp_file file("bmstu_mapped_vector_append.bin");
+	bmstu::mapped_vector<record> v(file.path());
+	const auto start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < kCount; ++i)
+	{
+		v.push_back({i, static_cast<double>(i)});
+	}
+	const std::chrono::duration<double> elapsed =
+		std::chrono::steady_clock::now() - start;
+	std::cout << "append: " << kCount / elapsed.count() / 1e6
+			  << " M records/s\n";
+}
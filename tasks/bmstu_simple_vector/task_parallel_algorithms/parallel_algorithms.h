@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "bmstu_simple_vector.h"
+#include "thread_pool.h"
+
+namespace bmstu
+{
+namespace detail
+{
+// Меньше этого число элементов не стоит отдавать в отдельную задачу.
+constexpr size_t kParallelGrain = 1 << 14;
+
+// Дожидается всех задач, даже если какая-то упала: задачи ссылаются на стек
+// вызывающего. Первое исключение пробрасывается.
+inline void wait_all(std::vector<std::future<void>>& pending,
+					 std::exception_ptr error = nullptr)
+{
+	for (auto& future : pending)
+	{
+		try
+		{
+			future.get();
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+// Делит [0, n) на куски и вызывает f(first, last) для каждого. Последний кусок
+// выполняет вызывающий поток, остальные — пул. Исключение из любого куска
+// пробрасывается наружу. Из задачи того же пула всё выполняется на месте:
+// ждать свои же задачи там нельзя, все потоки пула могут быть заняты.
+template <typename F>
+void parallel_chunks(thread_pool& pool, size_t n, F f)
+{
+	if (n == 0)
+	{
+		return;
+	}
+	if (pool.on_worker())
+	{
+		f(0, n);
+		return;
+	}
+	const size_t max_chunks = pool.size() * 4 + 1;
+	const size_t chunks =
+		std::max<size_t>(1, std::min(max_chunks, n / kParallelGrain));
+	const size_t step = (n + chunks - 1) / chunks;
+	std::vector<std::future<void>> pending;
+	pending.reserve(chunks);
+	size_t first = 0;
+	try
+	{
+		for (; first + step < n; first += step)
+		{
+			pending.push_back(pool.submit([&f, first, last = first + step]
+										  { f(first, last); }));
+		}
+	}
+	catch (...)
+	{
+		// Уже отправленные куски держат ссылку на f.
+		wait_all(pending, std::current_exception());
+	}
+	std::exception_ptr error;
+	try
+	{
+		f(first, n);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	wait_all(pending, error);
+}
+}  // namespace detail
+
+inline thread_pool& default_thread_pool()
+{
+	static thread_pool pool;
+	return pool;
+}
+
+template <typename T, typename F>
+void parallel_for_each(simple_vector<T>& v,
+					   F f,
+					   thread_pool& pool = default_thread_pool())
+{
+	T* data = v.data();
+	detail::parallel_chunks(pool, v.size(),
+							[data, &f](size_t first, size_t last)
+							{
+								for (size_t i = first; i < last; ++i)
+								{
+									f(data[i]);
+								}
+							});
+}
+
+// out получает размер in; out[i] = f(in[i]).
+template <typename T, typename U, typename F>
+void parallel_transform(const simple_vector<T>& in,
+						simple_vector<U>& out,
+						F f,
+						thread_pool& pool = default_thread_pool())
+{
+	out.resize(in.size());
+	const T* src = in.data();
+	U* dst = out.data();
+	detail::parallel_chunks(pool, in.size(),
+							[src, dst, &f](size_t first, size_t last)
+							{
+								for (size_t i = first; i < last; ++i)
+								{
+									dst[i] = f(src[i]);
+								}
+							});
+}
+
+// op должна быть ассоциативной: куски сворачиваются независимо, а затем
+// частичные результаты складываются слева направо.
+template <typename T, typename Init, typename Op = std::plus<>>
+Init parallel_reduce(const simple_vector<T>& v,
+					 Init init,
+					 Op op = {},
+					 thread_pool& pool = default_thread_pool())
+{
+	const size_t n = v.size();
+	if (n == 0)
+	{
+		return init;
+	}
+	const T* data = v.data();
+	std::mutex mutex;
+	std::vector<std::pair<size_t, Init>> partials;
+	detail::parallel_chunks(
+		pool, n,
+		[data, &op, &mutex, &partials](size_t first, size_t last)
+		{
+			Init acc = data[first];
+			for (size_t i = first + 1; i < last; ++i)
+			{
+				acc = op(std::move(acc), data[i]);
+			}
+			std::lock_guard lock(mutex);
+			partials.emplace_back(first, std::move(acc));
+		});
+	std::sort(partials.begin(), partials.end(),
+			  [](const auto& lhs, const auto& rhs)
+			  { return lhs.first < rhs.first; });
+	for (auto& partial : partials)
+	{
+		init = op(std::move(init), std::move(partial.second));
+	}
+	return init;
+}
+
+// Куски сортируются параллельно, затем сливаются попарно раундами; слияния
+// одного раунда тоже идут параллельно.
+template <typename T, typename Compare = std::less<>>
+void parallel_sort(simple_vector<T>& v,
+				   Compare comp = {},
+				   thread_pool& pool = default_thread_pool())
+{
+	const size_t n = v.size();
+	T* data = v.data();
+	std::mutex mutex;
+	std::vector<std::pair<size_t, size_t>> runs;
+	detail::parallel_chunks(pool, n,
+							[data, &comp, &mutex, &runs](size_t first,
+														 size_t last)
+							{
+								std::sort(data + first, data + last, comp);
+								std::lock_guard lock(mutex);
+								runs.emplace_back(first, last);
+							});
+	std::sort(runs.begin(), runs.end());
+	while (runs.size() > 1)
+	{
+		std::vector<std::pair<size_t, size_t>> merged;
+		std::vector<std::future<void>> pending;
+		try
+		{
+			for (size_t i = 0; i + 1 < runs.size(); i += 2)
+			{
+				const size_t first = runs[i].first;
+				const size_t middle = runs[i].second;
+				const size_t last = runs[i + 1].second;
+				merged.emplace_back(first, last);
+				pending.push_back(pool.submit(
+					[data, &comp, first, middle, last]
+					{
+						std::inplace_merge(data + first, data + middle,
+										   data + last, comp);
+					}));
+			}
+			if (runs.size() % 2 != 0)
+			{
+				merged.push_back(runs.back());
+			}
+		}
+		catch (...)
+		{
+			detail::wait_all(pending, std::current_exception());
+		}
+		detail::wait_all(pending);
+		runs.swap(merged);
+	}
+}
+}  // namespace bmstu
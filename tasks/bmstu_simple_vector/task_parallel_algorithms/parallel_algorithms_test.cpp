@@ -0,0 +1,209 @@
+#include "parallel_algorithms.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "bench.h"
+
+namespace
+{
+bmstu::simple_vector<int> random_vector(size_t size, uint32_t seed)
+{
+	bmstu::simple_vector<int> v(size);
+	std::mt19937 gen(seed);
+	for (int& x : v)
+	{
+		x = static_cast<int>(gen() % 1000000);
+	}
+	return v;
+}
+}  // namespace
+
+TEST(ThreadPool, RunsTasks)
+{
+	bmstu::thread_pool pool(4);
+	ASSERT_EQ(pool.size(), 4u);
+	std::atomic<int> counter{0};
+	std::vector<std::future<int>> results;
+	for (int i = 0; i < 100; ++i)
+	{
+		results.push_back(pool.submit(
+			[&counter, i]
+			{
+				++counter;
+				return i * i;
+			}));
+	}
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(results[i].get(), i * i);
+	}
+	ASSERT_EQ(counter.load(), 100);
+}
+
+TEST(ParallelAlgorithms, Sort)
+{
+	bmstu::thread_pool pool(4);
+	for (size_t size : {0u, 1u, 1000u, 300000u})
+	{
+		auto v = random_vector(size, 42);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		bmstu::parallel_sort(v, std::less<>(), pool);
+		ASSERT_EQ(v, expected);
+	}
+}
+
+TEST(ParallelAlgorithms, SortWithComparator)
+{
+	auto v = random_vector(200000, 7);
+	bmstu::parallel_sort(v, std::greater<>());
+	ASSERT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+}
+
+TEST(ParallelAlgorithms, Transform)
+{
+	bmstu::simple_vector<int> in(100000);
+	std::iota(in.begin(), in.end(), 0);
+	bmstu::simple_vector<std::string> out;
+	bmstu::parallel_transform(in, out, [](int x) { return std::to_string(x); });
+	ASSERT_EQ(out.size(), in.size());
+	ASSERT_EQ(out[0], "0");
+	ASSERT_EQ(out[99999], "99999");
+}
+
+TEST(ParallelAlgorithms, Reduce)
+{
+	bmstu::simple_vector<int> v(1000000, 1);
+	ASSERT_EQ(bmstu::parallel_reduce(v, int64_t{5}), 1000005);
+
+	bmstu::simple_vector<std::string> words(50000, "ab");
+	const std::string joined = bmstu::parallel_reduce(words, std::string("^"));
+	ASSERT_EQ(joined.size(), 100001u);
+	ASSERT_EQ(joined.substr(0, 3), "^ab");
+
+	bmstu::simple_vector<int> empty;
+	ASSERT_EQ(bmstu::parallel_reduce(empty, 7), 7);
+}
+
+TEST(ParallelAlgorithms, ForEach)
+{
+	bmstu::simple_vector<int> v(100000, 2);
+	bmstu::parallel_for_each(v, [](int& x) { x *= 3; });
+	ASSERT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 6; }));
+}
+
+TEST(ParallelAlgorithms, ExceptionPropagates)
+{
+	bmstu::simple_vector<int> v(100000);
+	std::iota(v.begin(), v.end(), 0);
+	ASSERT_THROW(bmstu::parallel_for_each(v,
+										  [](int& x)
+										  {
+											  if (x == 1234)
+											  {
+												  throw std::runtime_error(
+													  "boom");
+											  }
+										  }),
+				 std::runtime_error);
+}
+
+TEST(ParallelAlgorithms, NestedCallFromPoolTask)
+{
+	// Единственный поток пула не может ждать собственных задач.
+	bmstu::thread_pool pool(1);
+	ASSERT_FALSE(pool.on_worker());
+	auto v = random_vector(300000, 3);
+	auto expected = v;
+	std::sort(expected.begin(), expected.end());
+	pool.submit(
+			[&]
+			{
+				ASSERT_TRUE(pool.on_worker());
+				bmstu::parallel_for_each(v, [](int& x) { x += 1; }, pool);
+				bmstu::parallel_sort(v, std::less<>(), pool);
+			})
+		.get();
+	for (int& x : expected)
+	{
+		x += 1;
+	}
+	ASSERT_EQ(v, expected);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(ParallelAlgorithmsBench, DISABLED_Speedup)
+{
+	constexpr size_t kCount = 100'000'000;
+	auto sequential = random_vector(kCount, 1);
+	auto parallel = sequential;
+	bmstu::simple_vector<int> out;
+
+	std::cout << "threads: " << bmstu::default_thread_pool().size() << "\n";
+	std::cout << "sort: sequential "
+			  << measure_ms(
+					 [&] { std::sort(sequential.begin(), sequential.end()); })
+			  << " ms, parallel "
+			  << measure_ms([&] { bmstu::parallel_sort(parallel); }) << " ms\n";
+
+	std::cout << "transform: sequential "
+			  << measure_ms(
+					 [&]
+					 {
+						 out.resize(sequential.size());
+						 std::transform(sequential.begin(), sequential.end(),
+										out.begin(),
+										[](int x) { return x * 3 + 1; });
+					 })
+			  << " ms, parallel "
+			  << measure_ms(
+					 [&]
+					 {
+						 bmstu::parallel_transform(
+							 parallel, out, [](int x) { return x * 3 + 1; });
+					 })
+			  << " ms\n";
+
+	int64_t seq_sum = 0;
+	int64_t par_sum = 0;
+	std::cout << "reduce: sequential "
+			  << measure_ms(
+					 [&]
+					 {
+						 seq_sum = std::accumulate(
+							 sequential.begin(), sequential.end(), int64_t{0});
+					 })
+			  << " ms, parallel "
+			  << measure_ms(
+					 [&]
+					 {
+						 par_sum =
+							 bmstu::parallel_reduce(parallel, int64_t{0});
+					 })
+			  << " ms\n";
+	ASSERT_EQ(seq_sum, par_sum);
+
+	std::cout << "for_each: sequential "
+			  << measure_ms(
+					 [&]
+					 {
+						 std::for_each(sequential.begin(), sequential.end(),
+									   [](int& x) { x ^= 0x5a5a; });
+					 })
+			  << " ms, parallel "
+			  << measure_ms(
+					 [&]
+					 {
+						 bmstu::parallel_for_each(parallel,
+												  [](int& x) { x ^= 0x5a5a; });
+					 })
+			  << " ms\n";
+}
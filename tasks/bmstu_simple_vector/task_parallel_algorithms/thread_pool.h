@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bmstu
+{
+// Пул потоков фиксированного размера с общей очередью задач.
+class thread_pool
+{
+   public:
+	explicit thread_pool(
+		size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+	{
+		workers_.reserve(threads);
+		for (size_t i = 0; i < threads; ++i)
+		{
+			workers_.emplace_back([this] { work_(); });
+		}
+	}
+
+	thread_pool(const thread_pool& other) = delete;
+	thread_pool& operator=(const thread_pool& other) = delete;
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stopping_ = true;
+		}
+		cv_.notify_all();
+		for (std::thread& worker : workers_)
+		{
+			worker.join();
+		}
+	}
+
+	size_t size() const noexcept { return workers_.size(); }
+
+	// Вызван ли метод из потока этого пула. Задача, которая ждёт другие
+	// задачи того же пула, может занять последний свободный поток.
+	bool on_worker() const noexcept { return current_ == this; }
+
+	template <typename F>
+	std::future<std::invoke_result_t<F>> submit(F f)
+	{
+		using result = std::invoke_result_t<F>;
+		auto task =
+			std::make_shared<std::packaged_task<result()>>(std::move(f));
+		std::future<result> future = task->get_future();
+		{
+			std::lock_guard lock(mutex_);
+			tasks_.emplace_back([task] { (*task)(); });
+		}
+		cv_.notify_one();
+		return future;
+	}
+
+   private:
+	void work_()
+	{
+		current_ = this;
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock lock(mutex_);
+				cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+				if (tasks_.empty())
+				{
+					return;
+				}
+				task = std::move(tasks_.front());
+				tasks_.pop_front();
+			}
+			task();
+		}
+	}
+
+	std::vector<std::thread> workers_;
+	std::deque<std::function<void()>> tasks_;
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool stopping_ = false;
+
+	static inline thread_local const thread_pool* current_ = nullptr;
+};
+}  // namespace bmstu
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+
+namespace bmstu
+{
+// Что делать с push в заполненный буфер.
+enum class ring_overflow
+{
+	reject,	   // push возвращает false, буфер не меняется
+	overwrite  // затирается самый старый элемент с противоположного конца
+};
+
+// Кольцевой буфер фиксированной ёмкости на array_ptr. Ёмкость округляется
+// вверх до степени двойки, так что позиция считается маской, а не делением.
+// Все операции на концах — O(1), память не перевыделяется. Буфер, из
+// которого переместили, пуст и имеет ёмкость 0: push в него возвращает false.
+template <typename T>
+class ring_buffer
+{
+	template <bool Const>
+	class basic_iterator
+	{
+		using owner = std::conditional_t<Const, const ring_buffer, ring_buffer>;
+
+	   public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() = default;
+
+		basic_iterator(owner* buffer, size_t index) noexcept
+			: buffer_(buffer), index_(index)
+		{
+		}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(buffer_, index_);
+		}
+
+		reference operator*() const noexcept { return (*buffer_)[index_]; }
+
+		pointer operator->() const noexcept { return &**this; }
+
+		reference operator[](difference_type n) const noexcept
+		{
+			return (*buffer_)[index_ + n];
+		}
+
+		basic_iterator& operator++() noexcept
+		{
+			++index_;
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			--index_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			index_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			index_ -= n;
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator+(difference_type n,
+										basic_iterator it) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.index_) -
+				   static_cast<difference_type>(rhs.index_);
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ == rhs.index_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ <=> rhs.index_;
+		}
+
+	   private:
+		owner* buffer_ = nullptr;
+		size_t index_ = 0;
+	};
+
+   public:
+	using value_type = T;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	explicit ring_buffer(size_t capacity,
+						 ring_overflow policy = ring_overflow::reject)
+		: data_(std::bit_ceil(std::max<size_t>(capacity, 1))),
+		  mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1),
+		  policy_(policy)
+	{
+	}
+
+	ring_buffer(ring_buffer&& other) noexcept
+		: data_(std::move(other.data_)),
+		  mask_(std::exchange(other.mask_, 0)),
+		  head_(std::exchange(other.head_, 0)),
+		  size_(std::exchange(other.size_, 0)),
+		  policy_(other.policy_)
+	{
+	}
+
+	ring_buffer& operator=(ring_buffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			data_ = std::move(other.data_);
+			mask_ = std::exchange(other.mask_, 0);
+			head_ = std::exchange(other.head_, 0);
+			size_ = std::exchange(other.size_, 0);
+			policy_ = other.policy_;
+		}
+		return *this;
+	}
+
+	size_t size() const noexcept { return size_; }
+
+	size_t capacity() const noexcept { return data_ ? mask_ + 1 : 0; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	bool full() const noexcept { return size_ == capacity(); }
+
+	ring_overflow policy() const noexcept { return policy_; }
+
+	T& operator[](size_t index) noexcept
+	{
+		return data_[(head_ + index) & mask_];
+	}
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return data_[(head_ + index) & mask_];
+	}
+
+	T& at(size_t index)
+	{
+		check_(index);
+		return (*this)[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		check_(index);
+		return (*this)[index];
+	}
+
+	T& front() noexcept { return (*this)[0]; }
+
+	const T& front() const noexcept { return (*this)[0]; }
+
+	T& back() noexcept { return (*this)[size_ - 1]; }
+
+	const T& back() const noexcept { return (*this)[size_ - 1]; }
+
+	// false, если буфер полон и политика — reject, или ёмкость нулевая.
+	bool push_back(T value)
+	{
+		if (full())
+		{
+			if (policy_ == ring_overflow::reject || !data_)
+			{
+				return false;
+			}
+			head_ = (head_ + 1) & mask_;
+			--size_;
+		}
+		data_[(head_ + size_) & mask_] = std::move(value);
+		++size_;
+		return true;
+	}
+
+	bool push_front(T value)
+	{
+		if (full())
+		{
+			if (policy_ == ring_overflow::reject || !data_)
+			{
+				return false;
+			}
+			--size_;
+		}
+		head_ = (head_ - 1) & mask_;
+		data_[head_] = std::move(value);
+		++size_;
+		return true;
+	}
+
+	void pop_front() noexcept
+	{
+		if (size_ > 0)
+		{
+			head_ = (head_ + 1) & mask_;
+			--size_;
+		}
+	}
+
+	void pop_back() noexcept
+	{
+		if (size_ > 0)
+		{
+			--size_;
+		}
+	}
+
+	// Отбрасывает до n самых старых элементов.
+	void pop_front(size_t n) noexcept
+	{
+		n = std::min(n, size_);
+		head_ = (head_ + n) & mask_;
+		size_ -= n;
+	}
+
+	void clear() noexcept
+	{
+		head_ = 0;
+		size_ = 0;
+	}
+
+	// Содержимое по порядку — не больше двух непрерывных кусков памяти.
+	std::pair<std::span<T>, std::span<T>> as_spans() noexcept
+	{
+		const size_t first = std::min(size_, capacity() - head_);
+		return {std::span<T>(data_.get() + head_, first),
+				std::span<T>(data_.get(), size_ - first)};
+	}
+
+	std::pair<std::span<const T>, std::span<const T>> as_spans() const noexcept
+	{
+		const size_t first = std::min(size_, capacity() - head_);
+		return {std::span<const T>(data_.get() + head_, first),
+				std::span<const T>(data_.get(), size_ - first)};
+	}
+
+	// Копирует всё содержимое в dst двумя блочными копированиями.
+	T* copy_out(T* dst) const
+	{
+		const auto [first, second] = as_spans();
+		dst = std::copy(first.begin(), first.end(), dst);
+		return std::copy(second.begin(), second.end(), dst);
+	}
+
+	iterator begin() noexcept { return iterator(this, 0); }
+
+	iterator end() noexcept { return iterator(this, size_); }
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, size_);
+	}
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+   private:
+	void check_(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+	}
+
+	array_ptr<T> data_;
+	size_t mask_ = 0;
+	size_t head_ = 0;
+	size_t size_ = 0;
+	ring_overflow policy_ = ring_overflow::reject;
+};
+}  // namespace bmstu
@@ -0,0 +1,192 @@
+#include "ring_buffer.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench.h"
+
+TEST(RingBuffer, CapacityRoundsUpToPowerOfTwo)
+{
+	bmstu::ring_buffer<int> buffer(5);
+	ASSERT_EQ(buffer.capacity(), 8u);
+	ASSERT_TRUE(buffer.empty());
+	ASSERT_EQ(bmstu::ring_buffer<int>(0).capacity(), 1u);
+	ASSERT_EQ(bmstu::ring_buffer<int>(16).capacity(), 16u);
+}
+
+TEST(RingBuffer, FifoWrapsAround)
+{
+	bmstu::ring_buffer<std::string> buffer(4);
+	for (int round = 0; round < 10; ++round)
+	{
+		ASSERT_TRUE(buffer.push_back(std::to_string(round)));
+		ASSERT_TRUE(buffer.push_back(std::to_string(round + 100)));
+		ASSERT_EQ(buffer.front(), std::to_string(round));
+		buffer.pop_front();
+		ASSERT_EQ(buffer.front(), std::to_string(round + 100));
+		buffer.pop_front();
+	}
+	ASSERT_TRUE(buffer.empty());
+	buffer.pop_front();
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, BothEnds)
+{
+	bmstu::ring_buffer<int> buffer(8);
+	buffer.push_back(2);
+	buffer.push_back(3);
+	buffer.push_front(1);
+	buffer.push_front(0);
+	ASSERT_EQ(std::vector<int>(buffer.begin(), buffer.end()),
+			  (std::vector<int>{0, 1, 2, 3}));
+	ASSERT_EQ(buffer.back(), 3);
+	buffer.pop_back();
+	ASSERT_EQ(buffer.back(), 2);
+	ASSERT_EQ(buffer.at(0), 0);
+	ASSERT_THROW(buffer.at(3), std::out_of_range);
+}
+
+TEST(RingBuffer, RejectWhenFull)
+{
+	bmstu::ring_buffer<int> buffer(2);
+	ASSERT_TRUE(buffer.push_back(1));
+	ASSERT_TRUE(buffer.push_back(2));
+	ASSERT_TRUE(buffer.full());
+	ASSERT_FALSE(buffer.push_back(3));
+	ASSERT_FALSE(buffer.push_front(0));
+	ASSERT_EQ(std::vector<int>(buffer.begin(), buffer.end()),
+			  (std::vector<int>{1, 2}));
+}
+
+TEST(RingBuffer, OverwriteOldest)
+{
+	bmstu::ring_buffer<int> buffer(4, bmstu::ring_overflow::overwrite);
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_TRUE(buffer.push_back(i));
+	}
+	ASSERT_EQ(buffer.size(), 4u);
+	ASSERT_EQ(std::vector<int>(buffer.begin(), buffer.end()),
+			  (std::vector<int>{6, 7, 8, 9}));
+	buffer.push_front(5);
+	ASSERT_EQ(std::vector<int>(buffer.begin(), buffer.end()),
+			  (std::vector<int>{5, 6, 7, 8}));
+}
+
+TEST(RingBuffer, TwoSpanCopyOut)
+{
+	bmstu::ring_buffer<int> buffer(8, bmstu::ring_overflow::overwrite);
+	for (int i = 0; i < 11; ++i)
+	{
+		buffer.push_back(i);
+	}
+	const auto [first, second] = buffer.as_spans();
+	ASSERT_EQ(first.size() + second.size(), 8u);
+	ASSERT_EQ(first.front(), 3);
+	ASSERT_EQ(second.back(), 10);
+
+	std::vector<int> out(buffer.size());
+	ASSERT_EQ(buffer.copy_out(out.data()), out.data() + out.size());
+	ASSERT_EQ(out, (std::vector<int>{3, 4, 5, 6, 7, 8, 9, 10}));
+
+	buffer.pop_front(5);
+	ASSERT_EQ(buffer.size(), 3u);
+	ASSERT_EQ(buffer.front(), 8);
+	buffer.pop_front(100);
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, MoveAndRandomAccess)
+{
+	bmstu::ring_buffer<int> buffer(4);
+	buffer.push_back(3);
+	buffer.push_back(1);
+	buffer.push_back(2);
+	std::sort(buffer.begin(), buffer.end());
+	bmstu::ring_buffer<int> moved(std::move(buffer));
+	ASSERT_EQ(moved[0], 1);
+	ASSERT_EQ(moved[2], 3);
+	ASSERT_EQ(moved.end() - moved.begin(), 3);
+	bmstu::ring_buffer<int>::const_iterator it = moved.begin() + 1;
+	ASSERT_EQ(*it, 2);
+
+	ASSERT_TRUE(buffer.empty());
+	ASSERT_EQ(buffer.capacity(), 0u);
+	ASSERT_FALSE(buffer.push_back(5));
+	ASSERT_FALSE(buffer.push_front(5));
+	ASSERT_TRUE(buffer.as_spans().first.empty());
+
+	bmstu::ring_buffer<int> overwriting(2, bmstu::ring_overflow::overwrite);
+	bmstu::ring_buffer<int> target(std::move(overwriting));
+	ASSERT_FALSE(overwriting.push_back(5));
+	ASSERT_TRUE(overwriting.empty());
+	overwriting = std::move(moved);
+	ASSERT_EQ(overwriting.size(), 3u);
+	ASSERT_EQ(moved.capacity(), 0u);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(RingBufferBench, DISABLED_FifoVsDeque)
+{
+	constexpr size_t kOps = 100'000'000;
+	constexpr size_t kWindow = 1024;
+	int64_t ring_sum = 0;
+	int64_t deque_sum = 0;
+
+	bmstu::ring_buffer<int64_t> ring(kWindow);
+	const double ring_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kOps; ++i)
+			{
+				if (ring.full())
+				{
+					ring_sum += ring.front();
+					ring.pop_front();
+				}
+				ring.push_back(static_cast<int64_t>(i));
+			}
+		});
+
+	std::deque<int64_t> deque;
+	const double deque_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kOps; ++i)
+			{
+				if (deque.size() == kWindow)
+				{
+					deque_sum += deque.front();
+					deque.pop_front();
+				}
+				deque.push_back(static_cast<int64_t>(i));
+			}
+		});
+	ASSERT_EQ(ring_sum, deque_sum);
+
+	bmstu::ring_buffer<int64_t> overwrite(kWindow,
+										  bmstu::ring_overflow::overwrite);
+	const double overwrite_ms = measure_ms(
+		[&]
+		{
+			for (size_t i = 0; i < kOps; ++i)
+			{
+				overwrite.push_back(static_cast<int64_t>(i));
+			}
+		});
+	std::vector<int64_t> snapshot(kWindow);
+	const double copy_ms =
+		measure_ms([&] { overwrite.copy_out(snapshot.data()); });
+
+	std::cout << "fifo window " << kWindow << ": ring_buffer "
+			  << kOps / ring_ms / 1e3 << " M ops/s, std::deque "
+			  << kOps / deque_ms / 1e3 << " M ops/s\n";
+	std::cout << "overwrite push_back: " << kOps / overwrite_ms / 1e3
+			  << " M ops/s, copy_out " << copy_ms * 1e3 << " us\n";
+}
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Вектор из блоков фиксированного размера плюс индекс блоков.
+// Рост добавляет новый блок и никогда не перемещает элементы, поэтому ссылки
+// и указатели на элементы стабильны. Итераторы (как у std::deque)
+// инвалидируются, когда перевыделяется индекс блоков.
+template <typename T, size_t ChunkSize = 1024>
+class segmented_vector
+{
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+				  "ChunkSize must be a power of two");
+
+	static constexpr size_t kMask = ChunkSize - 1;
+	static constexpr size_t kShift = std::countr_zero(ChunkSize);
+
+	template <bool Const>
+	class basic_iterator
+	{
+		using chunk_ptr = std::conditional_t<Const, const T* const*, T* const*>;
+
+	   public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() = default;
+
+		basic_iterator(chunk_ptr chunks, size_t pos) noexcept
+			: chunks_(chunks), pos_(pos)
+		{
+		}
+
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(chunks_, pos_);
+		}
+
+		reference operator*() const noexcept
+		{
+			return chunks_[pos_ >> kShift][pos_ & kMask];
+		}
+
+		pointer operator->() const noexcept { return &**this; }
+
+		reference operator[](difference_type n) const noexcept
+		{
+			return *(*this + n);
+		}
+
+		basic_iterator& operator++() noexcept
+		{
+			++pos_;
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++pos_;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			--pos_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--pos_;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			pos_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			pos_ -= n;
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator+(difference_type n,
+										basic_iterator it) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.pos_) -
+				   static_cast<difference_type>(rhs.pos_);
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.pos_ == rhs.pos_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.pos_ <=> rhs.pos_;
+		}
+
+	   private:
+		chunk_ptr chunks_ = nullptr;
+		size_t pos_ = 0;
+	};
+
+	// Итератор по блокам: разыменование даёт непрерывный std::span элементов,
+	// так что алгоритм может обработать целый блок обычным циклом.
+	template <bool Const>
+	class basic_segment_iterator
+	{
+		using chunk_ptr = std::conditional_t<Const, const T* const*, T* const*>;
+		using element = std::conditional_t<Const, const T, T>;
+
+	   public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::span<element>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::span<element>;
+
+		basic_segment_iterator() = default;
+
+		basic_segment_iterator(chunk_ptr chunks, size_t chunk, size_t size)
+			: chunks_(chunks), chunk_(chunk), size_(size)
+		{
+		}
+
+		reference operator*() const noexcept
+		{
+			const size_t first = chunk_ * ChunkSize;
+			const size_t count =
+				size_ - first < ChunkSize ? size_ - first : ChunkSize;
+			return {chunks_[chunk_], count};
+		}
+
+		basic_segment_iterator& operator++() noexcept
+		{
+			++chunk_;
+			return *this;
+		}
+
+		basic_segment_iterator operator++(int) noexcept
+		{
+			basic_segment_iterator tmp = *this;
+			++chunk_;
+			return tmp;
+		}
+
+		friend bool operator==(const basic_segment_iterator& lhs,
+							   const basic_segment_iterator& rhs) noexcept
+		{
+			return lhs.chunk_ == rhs.chunk_;
+		}
+
+	   private:
+		chunk_ptr chunks_ = nullptr;
+		size_t chunk_ = 0;
+		size_t size_ = 0;
+	};
+
+	template <typename It>
+	struct segment_range
+	{
+		It first;
+		It last;
+
+		It begin() const noexcept { return first; }
+
+		It end() const noexcept { return last; }
+	};
+
+   public:
+	using value_type = T;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+	using segment_iterator = basic_segment_iterator<false>;
+	using const_segment_iterator = basic_segment_iterator<true>;
+
+	static constexpr size_t chunk_size = ChunkSize;
+
+	segmented_vector() noexcept = default;
+
+	segmented_vector(std::initializer_list<T> init) : segmented_vector()
+	{
+		for (const T& value : init)
+		{
+			push_back(value);
+		}
+	}
+
+	segmented_vector(const segmented_vector& other) : segmented_vector()
+	{
+		for (const T& value : other)
+		{
+			push_back(value);
+		}
+	}
+
+	segmented_vector(segmented_vector&& other) noexcept { swap(other); }
+
+	segmented_vector& operator=(const segmented_vector& other)
+	{
+		if (this != &other)
+		{
+			segmented_vector tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	segmented_vector& operator=(segmented_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			segmented_vector tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~segmented_vector()
+	{
+		for (T* chunk : chunks_)
+		{
+			delete[] chunk;
+		}
+	}
+
+	size_t size() const noexcept { return size_; }
+
+	size_t capacity() const noexcept { return chunks_.size() * ChunkSize; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	T& operator[](size_t index) noexcept
+	{
+		return chunks_[index >> kShift][index & kMask];
+	}
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return chunks_[index >> kShift][index & kMask];
+	}
+
+	T& at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	T& back() noexcept { return (*this)[size_ - 1]; }
+
+	const T& back() const noexcept { return (*this)[size_ - 1]; }
+
+	void reserve(size_t new_cap)
+	{
+		const size_t chunks = (new_cap + kMask) >> kShift;
+		chunks_.reserve(chunks);
+		while (chunks_.size() < chunks)
+		{
+			add_chunk_();
+		}
+	}
+
+	void push_back(const T& value)
+	{
+		T tmp = value;
+		push_back(std::move(tmp));
+	}
+
+	void push_back(T&& value)
+	{
+		if (size_ == capacity())
+		{
+			add_chunk_();
+		}
+		(*this)[size_] = std::move(value);
+		++size_;
+	}
+
+	void pop_back() noexcept
+	{
+		if (size_ > 0)
+		{
+			--size_;
+		}
+	}
+
+	// Блоки остаются выделенными и переиспользуются следующими push_back.
+	void clear() noexcept { size_ = 0; }
+
+	iterator begin() noexcept { return iterator(chunks_.data(), 0); }
+
+	iterator end() noexcept
+	{
+		return iterator(chunks_.data(), size_);
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(chunks_.data(), 0);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(chunks_.data(), size_);
+	}
+
+	segment_range<segment_iterator> segments() noexcept
+	{
+		return {segment_iterator(chunks_.data(), 0, size_),
+				segment_iterator(chunks_.data(),
+								 (size_ + kMask) >> kShift, size_)};
+	}
+
+	segment_range<const_segment_iterator> segments() const noexcept
+	{
+		return {const_segment_iterator(chunks_.data(), 0, size_),
+				const_segment_iterator(chunks_.data(),
+									   (size_ + kMask) >> kShift, size_)};
+	}
+
+	void swap(segmented_vector& other) noexcept
+	{
+		chunks_.swap(other.chunks_);
+		std::swap(size_, other.size_);
+	}
+
+	friend void swap(segmented_vector& lhs, segmented_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+	friend bool operator==(const segmented_vector& lhs,
+						   const segmented_vector& rhs)
+	{
+		if (lhs.size_ != rhs.size_)
+		{
+			return false;
+		}
+		for (size_t i = 0; i < lhs.size_; ++i)
+		{
+			if (!(lhs[i] == rhs[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+   private:
+	// Кусок принадлежит unique_ptr, пока его не взял chunks_: иначе он
+	// утечёт, если push_back бросит.
+	void add_chunk_()
+	{
+		std::unique_ptr<T[]> chunk(new T[ChunkSize]);
+		chunks_.push_back(chunk.get());
+		chunk.release();
+	}
+
+	simple_vector<T*> chunks_;
+	size_t size_ = 0;
+};
+}  // namespace bmstu
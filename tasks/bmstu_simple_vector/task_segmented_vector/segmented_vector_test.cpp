@@ -0,0 +1,259 @@
+#include "segmented_vector.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "bmstu_simple_vector.h"
+
+TEST(SegmentedVector, DefaultConstructor)
+{
+	bmstu::segmented_vector<int> v;
+	ASSERT_EQ(v.size(), 0u);
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.capacity(), 0u);
+	ASSERT_EQ(v.begin(), v.end());
+}
+
+TEST(SegmentedVector, PushBackAcrossChunks)
+{
+	bmstu::segmented_vector<int, 4> v;
+	for (int i = 0; i < 10; ++i)
+	{
+		v.push_back(i);
+	}
+	ASSERT_EQ(v.size(), 10u);
+	ASSERT_EQ(v.capacity(), 12u);
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(v[i], i);
+	}
+	ASSERT_EQ(v.back(), 9);
+}
+
+TEST(SegmentedVector, StableAddresses)
+{
+	bmstu::segmented_vector<std::string, 8> v;
+	v.push_back("first");
+	const std::string* first = &v[0];
+	for (int i = 0; i < 1000; ++i)
+	{
+		v.push_back(std::to_string(i));
+	}
+	ASSERT_EQ(first, &v[0]);
+	ASSERT_EQ(*first, "first");
+}
+
+TEST(SegmentedVector, At)
+{
+	bmstu::segmented_vector<int> v{1, 2, 3};
+	ASSERT_EQ(&v.at(2), &v[2]);
+	try
+	{
+		v.at(3);
+		FAIL();
+	}
+	catch (std::out_of_range const& err)
+	{
+		EXPECT_EQ(err.what(), std::string("Index out of range"));
+	}
+}
+
+TEST(SegmentedVector, Iterators)
+{
+	bmstu::segmented_vector<int, 4> v;
+	for (int i = 0; i < 10; ++i)
+	{
+		v.push_back(0);
+	}
+	std::iota(v.begin(), v.end(), 1);
+	ASSERT_EQ(v.end() - v.begin(), 10);
+	ASSERT_EQ(*(v.begin() + 5), 6);
+	ASSERT_EQ(std::accumulate(v.begin(), v.end(), 0), 55);
+
+	std::sort(v.begin(), v.end(), std::greater<>());
+	ASSERT_EQ(v[0], 10);
+	ASSERT_EQ(v[9], 1);
+
+	const auto& cv = v;
+	bmstu::segmented_vector<int, 4>::const_iterator it = v.begin();
+	ASSERT_EQ(it, cv.begin());
+	ASSERT_EQ(*std::find(cv.begin(), cv.end(), 3), 3);
+}
+
+TEST(SegmentedVector, Segments)
+{
+	bmstu::segmented_vector<int, 4> v;
+	for (int i = 0; i < 10; ++i)
+	{
+		v.push_back(i);
+	}
+	size_t segments = 0;
+	size_t total = 0;
+	int sum = 0;
+	for (auto segment : v.segments())
+	{
+		++segments;
+		total += segment.size();
+		for (int x : segment)
+		{
+			sum += x;
+		}
+	}
+	ASSERT_EQ(segments, 3u);
+	ASSERT_EQ(total, 10u);
+	ASSERT_EQ(sum, 45);
+}
+
+TEST(SegmentedVector, ClearKeepsChunks)
+{
+	bmstu::segmented_vector<int, 4> v{1, 2, 3, 4, 5};
+	const int* first = &v[0];
+	const size_t old_capacity = v.capacity();
+	v.clear();
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.capacity(), old_capacity);
+	v.push_back(42);
+	ASSERT_EQ(&v[0], first);
+}
+
+TEST(SegmentedVector, CopyMoveCompare)
+{
+	bmstu::segmented_vector<int, 4> v{1, 2, 3, 4, 5, 6};
+	bmstu::segmented_vector<int, 4> copy(v);
+	ASSERT_EQ(copy, v);
+	ASSERT_NE(&copy[0], &v[0]);
+
+	bmstu::segmented_vector<int, 4> moved(std::move(copy));
+	ASSERT_EQ(moved, v);
+	ASSERT_EQ(copy.size(), 0u);
+
+	moved.pop_back();
+	ASSERT_FALSE(moved == v);
+}
+
+TEST(SegmentedVector, Reserve)
+{
+	bmstu::segmented_vector<int, 4> v;
+	v.reserve(9);
+	ASSERT_EQ(v.capacity(), 12u);
+	ASSERT_TRUE(v.empty());
+}
+
+namespace
+{
+// Считает живые объекты; копирование бросает, когда copies_left дойдёт до 0.
+struct counted
+{
+	static inline int live = 0;
+	static inline int copies_left = -1;
+
+	int value = 0;
+
+	counted() { ++live; }
+
+	counted(int v) : value(v) { ++live; }
+
+	counted(const counted& other) : value(other.value)
+	{
+		if (copies_left == 0)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		--copies_left;
+		++live;
+	}
+
+	counted& operator=(const counted& other) = default;
+
+	~counted() { --live; }
+};
+}  // namespace
+
+TEST(SegmentedVector, FailedCopyFreesChunks)
+{
+	{
+		bmstu::segmented_vector<counted, 4> source;
+		for (int i = 0; i < 6; ++i)
+		{
+			source.push_back(counted(i));
+		}
+		const int live = counted::live;
+		counted::copies_left = 5;
+		ASSERT_THROW((bmstu::segmented_vector<counted, 4>(source)),
+					 std::runtime_error);
+		counted::copies_left = -1;
+		ASSERT_EQ(counted::live, live);
+	}
+	ASSERT_EQ(counted::live, 0);
+}
+
+namespace
+{
+// Гистограмма задержек по степеням двойки (нс), чтобы не хранить 10^8 замеров.
+struct latency_histogram
+{
+	uint64_t buckets[64] = {};
+	uint64_t max_ns = 0;
+	uint64_t count = 0;
+
+	void add(uint64_t ns)
+	{
+		++buckets[ns == 0 ? 0 : 64 - std::countl_zero(ns)];
+		max_ns = std::max(max_ns, ns);
+		++count;
+	}
+
+	uint64_t percentile(double p) const
+	{
+		const auto target = static_cast<uint64_t>(p * count);
+		uint64_t seen = 0;
+		for (int i = 0; i < 64; ++i)
+		{
+			seen += buckets[i];
+			if (seen >= target)
+			{
+				return i == 0 ? 0 : (uint64_t{1} << i);
+			}
+		}
+		return max_ns;
+	}
+};
+
+template <typename Vector>
+latency_histogram measure_push_back(size_t count)
+{
+	Vector v;
+	latency_histogram hist;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		v.push_back(static_cast<int>(i));
+		const auto stop = std::chrono::steady_clock::now();
+		hist.add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop -
+																	  start)
+					 .count());
+	}
+	return hist;
+}
+
+void print_histogram(const char* name, const latency_histogram& hist)
+{
+	std::cout << name << ": p50 <= " << hist.percentile(0.5)
+			  << " ns, p99.99 <= " << hist.percentile(0.9999)
+			  << " ns, max = " << hist.max_ns << " ns\n";
+}
+}  // namespace
+
+TEST(SegmentedVectorBench, DISABLED_PushBackTailLatency)
+{
+	constexpr size_t kCount = 100'000'000;
+	print_histogram("simple_vector",
+					measure_push_back<bmstu::simple_vector<int>>(kCount));
+	print_histogram("segmented_vector",
+					measure_push_back<bmstu::segmented_vector<int>>(kCount));
+}
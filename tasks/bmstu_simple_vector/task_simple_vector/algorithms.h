@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bmstu::detail
+{
+// Обмен через перемещение: для строк и других тяжёлых типов это обмен
+// указателями, а не две глубокие копии.
+template <typename T>
+void swap_values(T& a, T& b) noexcept(
+	std::is_nothrow_move_constructible_v<T> &&
+	std::is_nothrow_move_assignable_v<T>)
+{
+	T tmp = std::move(a);
+	a = std::move(b);
+	b = std::move(tmp);
+}
+
+// Если все байты представления value одинаковы, возвращает этот байт.
+template <typename T>
+bool single_byte_pattern(const T& value, unsigned char& byte) noexcept
+{
+	unsigned char bytes[sizeof(T)];
+	std::memcpy(bytes, &value, sizeof(T));
+	byte = bytes[0];
+	return std::all_of(bytes, bytes + sizeof(T),
+					   [b = bytes[0]](unsigned char x) { return x == b; });
+}
+
+// Присваивает value элементам [first, first + n). Для тривиально копируемых
+// T заполнение одинаковыми байтами (нули, -1) сводится к memset. Остальное
+// идёт прежним циклом присваивания, который компилятор и так векторизует.
+template <typename T>
+void fill_n(T* first, size_t n, const T& value)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		unsigned char byte = 0;
+		if (n != 0 && single_byte_pattern(value, byte))
+		{
+			std::memset(static_cast<void*>(first), byte, n * sizeof(T));
+			return;
+		}
+	}
+	for (size_t i = 0; i < n; ++i)
+	{
+		first[i] = value;
+	}
+}
+
+template <typename T>
+void destroy_n(T* first, size_t n) noexcept
+{
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			first[i].~T();
+		}
+	}
+}
+
+// Варианты для сырой памяти: конструируют объекты на месте. Если
+// конструктор бросает, уже созданные объекты уничтожаются.
+template <typename T>
+T* uninitialized_fill_n(T* first, size_t n, const T& value)
+{
+	if constexpr (std::is_trivially_copyable_v<T> &&
+				  std::is_trivially_default_constructible_v<T>)
+	{
+		fill_n(first, n, value);
+		return first + n;
+	}
+	else
+	{
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i)
+			{
+				::new (static_cast<void*>(first + i)) T(value);
+			}
+		}
+		catch (...)
+		{
+			destroy_n(first, i);
+			throw;
+		}
+		return first + n;
+	}
+}
+
+template <typename T>
+T* uninitialized_copy_n(const T* src, size_t n, T* dst)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		if (n != 0)
+		{
+			std::memcpy(static_cast<void*>(dst), src, n * sizeof(T));
+		}
+		return dst + n;
+	}
+	else
+	{
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i)
+			{
+				::new (static_cast<void*>(dst + i)) T(src[i]);
+			}
+		}
+		catch (...)
+		{
+			destroy_n(dst, i);
+			throw;
+		}
+		return dst + n;
+	}
+}
+
+// Перемещает, если перемещение не бросает; иначе копирует, чтобы при
+// исключении исходный диапазон остался целым.
+template <typename T>
+T* uninitialized_move_n(T* src, size_t n, T* dst)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		return uninitialized_copy_n(src, n, dst);
+	}
+	else
+	{
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i)
+			{
+				::new (static_cast<void*>(dst + i))
+					T(std::move_if_noexcept(src[i]));
+			}
+		}
+		catch (...)
+		{
+			destroy_n(dst, i);
+			throw;
+		}
+		return dst + n;
+	}
+}
+}  // namespace bmstu::detail
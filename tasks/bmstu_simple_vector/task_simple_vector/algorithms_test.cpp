@@ -0,0 +1,236 @@
+#include "algorithms.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "bmstu_simple_vector.h"
+
+namespace
+{
+struct swap_tracker
+{
+	static int copies;
+	std::string value;
+
+	explicit swap_tracker(std::string v = {}) : value(std::move(v)) {}
+
+	swap_tracker(const swap_tracker& other) : value(other.value) { ++copies; }
+
+	swap_tracker(swap_tracker&& other) noexcept = default;
+
+	swap_tracker& operator=(const swap_tracker& other)
+	{
+		value = other.value;
+		++copies;
+		return *this;
+	}
+
+	swap_tracker& operator=(swap_tracker&& other) noexcept = default;
+};
+
+int swap_tracker::copies = 0;
+
+// Бросает на третьем копировании.
+struct fragile
+{
+	static int alive;
+	static int copies_left;
+
+	fragile() { ++alive; }
+
+	fragile(const fragile&)
+	{
+		if (copies_left-- == 0)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		++alive;
+	}
+
+	~fragile() { --alive; }
+};
+
+int fragile::alive = 0;
+int fragile::copies_left = 0;
+
+template <typename T>
+struct raw_buffer
+{
+	explicit raw_buffer(size_t n)
+		: memory(static_cast<T*>(::operator new(n * sizeof(T))))
+	{
+	}
+
+	~raw_buffer() { ::operator delete(memory); }
+
+	T* memory;
+};
+}  // namespace
+
+TEST(Algorithms, SwapMovesInsteadOfCopying)
+{
+	swap_tracker a("left");
+	swap_tracker b("right");
+	swap_tracker::copies = 0;
+	bmstu::detail::swap_values(a, b);
+	ASSERT_EQ(a.value, "right");
+	ASSERT_EQ(b.value, "left");
+	ASSERT_EQ(swap_tracker::copies, 0);
+}
+
+TEST(Algorithms, FillTrivialAndNonTrivial)
+{
+	std::vector<int> zeros(100, 7);
+	bmstu::detail::fill_n(zeros.data(), zeros.size(), 0);
+	ASSERT_EQ(zeros, std::vector<int>(100, 0));
+
+	std::vector<int> ones(100);
+	bmstu::detail::fill_n(ones.data(), ones.size(), -1);
+	ASSERT_EQ(ones, std::vector<int>(100, -1));
+
+	std::vector<double> pattern(33);
+	bmstu::detail::fill_n(pattern.data(), pattern.size(), 2.5);
+	ASSERT_EQ(pattern, std::vector<double>(33, 2.5));
+
+	std::vector<std::string> words(5);
+	bmstu::detail::fill_n(words.data(), words.size(), std::string("abc"));
+	ASSERT_EQ(words, std::vector<std::string>(5, "abc"));
+
+	bmstu::detail::fill_n<int>(nullptr, 0, 0);
+}
+
+TEST(Algorithms, UninitializedCopyAndMove)
+{
+	raw_buffer<std::string> copied(3);
+	const std::string src[3] = {"a", "b", std::string(100, 'c')};
+	bmstu::detail::uninitialized_copy_n(src, 3, copied.memory);
+	ASSERT_EQ(copied.memory[2], src[2]);
+
+	raw_buffer<std::string> moved(3);
+	bmstu::detail::uninitialized_move_n(copied.memory, 3, moved.memory);
+	ASSERT_EQ(moved.memory[2], src[2]);
+	ASSERT_TRUE(copied.memory[2].empty());
+	bmstu::detail::destroy_n(copied.memory, 3);
+	bmstu::detail::destroy_n(moved.memory, 3);
+
+	raw_buffer<int> ints(4);
+	bmstu::detail::uninitialized_fill_n(ints.memory, 4, 9);
+	ASSERT_EQ(ints.memory[3], 9);
+}
+
+TEST(Algorithms, UninitializedRollsBackOnException)
+{
+	raw_buffer<fragile> buffer(5);
+	const fragile prototype;
+	fragile::copies_left = 2;
+	ASSERT_THROW(
+		bmstu::detail::uninitialized_fill_n(buffer.memory, 5, prototype),
+		std::runtime_error);
+	ASSERT_EQ(fragile::alive, 1);
+}
+
+TEST(Algorithms, SimpleVectorFillSemantics)
+{
+	bmstu::simple_vector<int> v(1000);
+	ASSERT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+	v.resize(2000);
+	ASSERT_EQ(v[1999], 0);
+	bmstu::simple_vector<std::string> words(3, "x");
+	ASSERT_EQ(words[2], "x");
+}
+
+namespace
+{
+// Прежние помощники из array_ptr.h — для сравнения.
+template <typename T>
+void naive_fill(T* ptr, size_t size, const T& value)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		ptr[i] = value;
+	}
+}
+
+template <typename T>
+void copy_swap(T& a, T& b)
+{
+	T tmp = a;
+	a = b;
+	b = tmp;
+}
+
+template <typename F>
+double measure_ns(size_t ops, F f)
+{
+	return bmstu::bench::measure_ms(f) * 1e6 / ops;
+}
+
+struct block64
+{
+	int64_t words[8];
+};
+
+template <typename T>
+void bench_type(const char* name, const T& fill_value, size_t count)
+{
+	std::unique_ptr<T[]> buffer(new T[count]);
+	T* data = buffer.get();
+	// Первый проход только подгружает страницы. Одиночный замер здесь
+	// шумит сильнее разницы, поэтому берётся лучший из пяти чередующихся.
+	naive_fill(data, count, fill_value);
+	const T zero{};
+	const auto fill_naive = [&] { naive_fill(data, count, fill_value); };
+	const auto fill_layered = [&]
+	{ bmstu::detail::fill_n(data, count, fill_value); };
+	const auto fill_zero = [&] { bmstu::detail::fill_n(data, count, zero); };
+	double naive = 1e300;
+	double layered = 1e300;
+	double zero_fill = 1e300;
+	for (int rep = 0; rep < 5; ++rep)
+	{
+		naive = std::min(naive, measure_ns(count, fill_naive));
+		layered = std::min(layered, measure_ns(count, fill_layered));
+		zero_fill = std::min(zero_fill, measure_ns(count, fill_zero));
+	}
+
+	constexpr size_t kSwaps = 1'000'000;
+	T a = fill_value;
+	T b{};
+	const double swap_copy = measure_ns(kSwaps,
+										[&]
+										{
+											for (size_t i = 0; i < kSwaps; ++i)
+											{
+												copy_swap(a, b);
+											}
+										});
+	const double swap_move =
+		measure_ns(kSwaps,
+				   [&]
+				   {
+					   for (size_t i = 0; i < kSwaps; ++i)
+					   {
+						   bmstu::detail::swap_values(a, b);
+					   }
+				   });
+	std::cout << name << ": fill " << naive << " -> " << layered
+			  << " ns/elem (zero " << zero_fill << "), swap " << swap_copy
+			  << " -> " << swap_move << " ns\n";
+}
+}  // namespace
+
+TEST(AlgorithmsBench, DISABLED_FillAndSwap)
+{
+	bench_type<char>("char", 'x', 100'000'000);
+	bench_type<int>("int", 42, 50'000'000);
+	bench_type<double>("double", 1.5, 50'000'000);
+	bench_type<block64>("block64", block64{{1, 2, 3, 4, 5, 6, 7, 8}},
+						5'000'000);
+	bench_type<std::string>("string(64)", std::string(64, 's'), 2'000'000);
+}
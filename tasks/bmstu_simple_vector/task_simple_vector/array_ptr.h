@@ -1,20 +1,8 @@
 #pragma once
 #include <algorithm>
+#include <cstddef>
 #include <type_traits>
-
-namespace {
-template <typename T>
-void my_fill(T* ptr, size_t size, const T& value = {}) {
-    for (size_t i = 0; i < size; ++i) ptr[i] = value;
-}
-
-template <typename T>
-void my_swap(T& a, T& b) {
-    T tmp = a;
-    a = b;
-    b = tmp;
-}
-}
+#include "algorithms.h"
 
 namespace bmstu {
 template <typename T>
@@ -25,7 +13,7 @@ public:
     explicit array_ptr(size_t size) {
         if (size > 0) {
             raw_ptr_ = new T[size];
-            my_fill(raw_ptr_, size);
+            detail::fill_n(raw_ptr_, size, T{});
         }
     }
 
@@ -52,7 +40,9 @@ public:
     T* get() const noexcept { return raw_ptr_; }
     explicit operator bool() const noexcept { return raw_ptr_ != nullptr; }
     
-    void swap(array_ptr& other) noexcept { my_swap(raw_ptr_, other.raw_ptr_); }
+    void swap(array_ptr& other) noexcept {
+        detail::swap_values(raw_ptr_, other.raw_ptr_);
+    }
 
     const T& operator[](size_t index) const { return raw_ptr_[index]; }
     T& operator[](size_t index) { return raw_ptr_[index]; }
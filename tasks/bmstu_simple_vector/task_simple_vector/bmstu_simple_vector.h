@@ -1,5 +1,12 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include "array_ptr.h"
 
@@ -9,94 +16,125 @@ template <typename T>
 class simple_vector
 {
    public:
-	class iterator
+	template <bool Const>
+	class basic_iterator
 	{
 	   public:
-		using iterator_category = std::contiguous_iterator_tag;
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::contiguous_iterator_tag;
 		using value_type = T;
-		using pointer = T*;
-		using reference = T&;
+		using element_type = std::conditional_t<Const, const T, T>;
+		using pointer = element_type*;
+		using reference = element_type&;
 		using difference_type = std::ptrdiff_t;
 
-		iterator() = default;
+		basic_iterator() = default;
 
-		iterator(const iterator& other) = default;
+		basic_iterator(const basic_iterator& other) = default;
 
-		iterator(std::nullptr_t) noexcept : ptr_(nullptr) {}
+		basic_iterator(std::nullptr_t) noexcept : ptr_(nullptr) {}
 
-		iterator(iterator&& other) noexcept : ptr_(nullptr) {}
+		explicit basic_iterator(pointer ptr) : ptr_(ptr) {}
 
-		explicit iterator(pointer ptr) : ptr_(ptr) {}
+		operator basic_iterator<true>() const noexcept
+		{
+			return basic_iterator<true>(ptr_);
+		}
 
 		reference operator*() const { return *ptr_; }
 
-		pointer operator->() { return nullptr; }
+		pointer operator->() const { return ptr_; }
 
-		iterator& operator=(const iterator& other) = default;
+		reference operator[](difference_type n) const { return ptr_[n]; }
 
-		iterator& operator=(iterator&& other) noexcept { return *this; }
+		basic_iterator& operator=(const basic_iterator& other) = default;
 
 #pragma region Operators
-		iterator& operator++() { return *this; }
+		basic_iterator& operator++()
+		{
+			++ptr_;
+			return *this;
+		}
 
-		iterator& operator--() { return *this; }
+		basic_iterator& operator--()
+		{
+			--ptr_;
+			return *this;
+		}
 
-		iterator operator++(int) { return *this; }
+		basic_iterator operator++(int)
+		{
+			basic_iterator tmp = *this;
+			++ptr_;
+			return tmp;
+		}
 
-		iterator operator--(int) { return *this; }
+		basic_iterator operator--(int)
+		{
+			basic_iterator tmp = *this;
+			--ptr_;
+			return tmp;
+		}
 
 		explicit operator bool() const { return ptr_ != nullptr; }
 
-		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs)
 		{
-			return "false";
+			return lhs.ptr_ == rhs.ptr_;
 		}
 
-		friend bool operator==(const iterator& lhs, std::nullptr_t)
+		friend bool operator==(const basic_iterator& lhs, std::nullptr_t)
 		{
-			return "false";
+			return lhs.ptr_ == nullptr;
 		}
 
-		iterator& operator=(std::nullptr_t) noexcept
+		basic_iterator& operator=(std::nullptr_t) noexcept
 		{
 			ptr_ = nullptr;
 			return *this;
 		}
 
-		friend bool operator==(std::nullptr_t, const iterator& rhs)
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs)
 		{
-			return true;
+			return lhs.ptr_ <=> rhs.ptr_;
 		}
 
-		friend bool operator!=(const iterator& lhs, const iterator& rhs)
+		friend basic_iterator operator+(const basic_iterator& it,
+										difference_type n) noexcept
 		{
-			return true;
+			return basic_iterator(it.ptr_ + n);
 		}
 
-		iterator operator+(const difference_type& n) const noexcept
+		friend basic_iterator operator+(difference_type n,
+										const basic_iterator& it) noexcept
 		{
-			return nullptr;
+			return basic_iterator(it.ptr_ + n);
 		}
 
-		iterator operator+=(const difference_type& n) noexcept
+		basic_iterator& operator+=(difference_type n) noexcept
 		{
-			return nullptr;
+			ptr_ += n;
+			return *this;
 		}
 
-		iterator operator-(const difference_type& n) const noexcept
+		friend basic_iterator operator-(const basic_iterator& it,
+										difference_type n) noexcept
 		{
-			return nullptr;
+			return basic_iterator(it.ptr_ - n);
 		}
 
-		iterator operator-=(const difference_type& n) noexcept
+		basic_iterator& operator-=(difference_type n) noexcept
 		{
-			return nullptr;
+			ptr_ -= n;
+			return *this;
 		}
 
-		friend difference_type operator-(const iterator& end,
-										 const iterator& begin) noexcept
+		friend difference_type operator-(const basic_iterator& end,
+										 const basic_iterator& begin) noexcept
 		{
-			return 0;
+			return end.ptr_ - begin.ptr_;
 		}
 
 #pragma endregion
@@ -104,102 +142,256 @@ class simple_vector
 		pointer ptr_ = nullptr;
 	};
 
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
 	simple_vector() noexcept = default;
 
 	~simple_vector() = default;
 
-	simple_vector(std::initializer_list<T> init) noexcept {}
+	simple_vector(std::initializer_list<T> init)
+		: data_(init.size()), size_(init.size()), capacity_(init.size())
+	{
+		std::copy(init.begin(), init.end(), data_.get());
+	}
 
-	simple_vector(const simple_vector& other) {}
+	simple_vector(const simple_vector& other)
+		: data_(other.size_), size_(other.size_), capacity_(other.size_)
+	{
+		std::copy(other.data_.get(), other.data_.get() + other.size_,
+				  data_.get());
+	}
 
 	simple_vector(simple_vector&& other) noexcept { swap(other); }
 
-	simple_vector& operator=(const simple_vector& other) { return *this; }
+	simple_vector& operator=(const simple_vector& other)
+	{
+		if (this != &other)
+		{
+			simple_vector tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
 
-	simple_vector(size_t size, const T& value = T{}) {}
+	simple_vector& operator=(simple_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			simple_vector tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
 
-	iterator begin() noexcept { return nullptr; }
+	simple_vector(size_t size, const T& value = T{})
+		: data_(size), size_(size), capacity_(size)
+	{
+		detail::fill_n(data_.get(), size, value);
+	}
 
-	iterator end() noexcept { return nullptr; }
+	iterator begin() noexcept { return iterator(data_.get()); }
 
-	using const_iterator = iterator;
+	iterator end() noexcept { return iterator(data_.get() + size_); }
 
-	const_iterator begin() const noexcept { return nullptr; }
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(data_.get());
+	}
 
-	const_iterator end() const noexcept { return nullptr; }
+	const_iterator end() const noexcept
+	{
+		return const_iterator(data_.get() + size_);
+	}
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
 
 	typename iterator::reference operator[](size_t index) noexcept
 	{
-		return data_[0];
+		return data_[index];
 	}
 
-	typename const_iterator::reference operator[](size_t index) const noexcept
+	const T& operator[](size_t index) const noexcept
 	{
-		return data_[0];
+		return data_[index];
 	}
 
-	typename iterator::reference at(size_t index) { return data_.get()[1]; }
+	typename iterator::reference at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_[index];
+	}
 
-	typename const_iterator::reference at(size_t index) const
+	const T& at(size_t index) const
 	{
-		return data_.get()[1];
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_[index];
 	}
 
-	size_t size() const noexcept { return 1; }
+	T* data() noexcept { return data_.get(); }
+
+	const T* data() const noexcept { return data_.get(); }
 
-	size_t capacity() const noexcept { return 100500; }
+	size_t size() const noexcept { return size_; }
 
-	void swap(simple_vector& other) noexcept {}
+	size_t capacity() const noexcept { return capacity_; }
 
-	friend void swap(simple_vector& lhs, simple_vector& rhs) noexcept {}
+	void swap(simple_vector& other) noexcept
+	{
+		data_.swap(other.data_);
+		std::swap(size_, other.size_);
+		std::swap(capacity_, other.capacity_);
+	}
 
-	void reserve(size_t new_cap) {}
+	friend void swap(simple_vector& lhs, simple_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
 
-	void resize(size_t new_size) { return; }
+	void reserve(size_t new_cap)
+	{
+		if (new_cap <= capacity_)
+		{
+			return;
+		}
+		array_ptr<T> new_data(new_cap);
+		std::move(data_.get(), data_.get() + size_, new_data.get());
+		data_.swap(new_data);
+		capacity_ = new_cap;
+	}
 
-	iterator insert(const_iterator where, T&& value) { return nullptr; }
+	void resize(size_t new_size)
+	{
+		if (new_size > capacity_)
+		{
+			reserve(std::max(new_size, capacity_ * 2));
+		}
+		if (new_size > size_)
+		{
+			detail::fill_n(data_.get() + size_, new_size - size_, T{});
+		}
+		size_ = new_size;
+	}
 
-	iterator insert(const_iterator where, const T& value) { return nullptr; }
+	iterator insert(const_iterator where, T&& value)
+	{
+		const size_t index = where - cbegin();
+		if (size_ == capacity_)
+		{
+			reserve(grown_capacity_());
+		}
+		std::move_backward(data_.get() + index, data_.get() + size_,
+						   data_.get() + size_ + 1);
+		data_[index] = std::move(value);
+		++size_;
+		return begin() + index;
+	}
 
-	void push_back(T&& value) {}
+	iterator insert(const_iterator where, const T& value)
+	{
+		T tmp = value;
+		return insert(where, std::move(tmp));
+	}
 
-	void clear() noexcept {}
+	void push_back(T&& value)
+	{
+		if (size_ == capacity_)
+		{
+			reserve(grown_capacity_());
+		}
+		data_[size_] = std::move(value);
+		++size_;
+	}
 
-	void push_back(const T& value) {}
+	void clear() noexcept { size_ = 0; }
 
-	bool empty() const noexcept { return false; }
+	void push_back(const T& value)
+	{
+		T tmp = value;
+		push_back(std::move(tmp));
+	}
 
-	void pop_back() { return; }
+	bool empty() const noexcept { return size_ == 0; }
+
+	void pop_back()
+	{
+		if (size_ > 0)
+		{
+			--size_;
+		}
+	}
 
 	friend bool operator==(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return true;
+		return lhs.size_ == rhs.size_ &&
+			   std::equal(lhs.data_.get(), lhs.data_.get() + lhs.size_,
+						  rhs.data_.get());
 	}
 
 	friend bool operator!=(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return false;
+		return !(lhs == rhs);
 	}
 
 	friend auto operator<=>(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return true;
+		if (alphabet_compare(lhs, rhs))
+		{
+			return std::strong_ordering::less;
+		}
+		if (alphabet_compare(rhs, lhs))
+		{
+			return std::strong_ordering::greater;
+		}
+		return std::strong_ordering::equal;
 	}
 
 	friend std::ostream& operator<<(std::ostream& os, const simple_vector& vec)
 	{
-		return os;
+		os << "{";
+		for (size_t i = 0; i < vec.size_; ++i)
+		{
+			if (i != 0)
+			{
+				os << ", ";
+			}
+			os << vec.data_[i];
+		}
+		return os << "}";
+	}
+	iterator erase(const_iterator where)
+	{
+		const size_t index = where - cbegin();
+		std::move(data_.get() + index + 1, data_.get() + size_,
+				  data_.get() + index);
+		--size_;
+		return begin() + index;
 	}
-	iterator erase(iterator where) { return nullptr; }
 
    private:
 	static bool alphabet_compare(const simple_vector<T>& lhs,
 								 const simple_vector<T>& rhs)
 	{
-		return false;
+		return std::lexicographical_compare(
+			lhs.data_.get(), lhs.data_.get() + lhs.size_, rhs.data_.get(),
+			rhs.data_.get() + rhs.size_);
 	}
+
+	size_t grown_capacity_() const noexcept
+	{
+		return capacity_ == 0 ? 1 : capacity_ * 2;
+	}
+
 	array_ptr<T> data_;
 	size_t size_ = 0;
 	size_t capacity_ = 0;
 };
-}  // namespace bmstu
\ No newline at end of file
+}  // namespace bmstu
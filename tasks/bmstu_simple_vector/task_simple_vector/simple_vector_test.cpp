@@ -467,4 +467,31 @@ TEST(SimpleVector, PushBackCopyMove3)
 	v.push_back(42);
 	auto it = v.begin();
 	it = nullptr;
-}
\ No newline at end of file
+}
+
+TEST(SimpleVector, ContiguousIterator)
+{
+	using vector = bmstu::simple_vector<int>;
+	static_assert(std::contiguous_iterator<vector::iterator>);
+	static_assert(std::contiguous_iterator<vector::const_iterator>);
+	static_assert(std::ranges::contiguous_range<vector>);
+	static_assert(std::ranges::contiguous_range<const vector>);
+	static_assert(
+		std::is_same_v<std::iter_reference_t<vector::const_iterator>,
+					   const int&>);
+	static_assert(
+		!std::is_convertible_v<vector::const_iterator, vector::iterator>);
+
+	vector v{5, 3, 1, 4, 2};
+	std::ranges::sort(v);
+	ASSERT_EQ(v, (vector{1, 2, 3, 4, 5}));
+	ASSERT_EQ(std::to_address(v.begin() + 2), &v[2]);
+	ASSERT_EQ(std::ranges::distance(v), 5);
+
+	const vector& cv = v;
+	vector::const_iterator it = v.begin();
+	ASSERT_EQ(it, cv.begin());
+	ASSERT_TRUE(it < cv.end());
+	ASSERT_EQ(it[4], 5);
+	ASSERT_EQ(*std::ranges::find(cv, 3), 3);
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Структура массивов: каждое поле записи лежит в своём непрерывном
+// simple_vector. Проход по одной колонке (column<I>()) читает только её байты
+// и векторизуется компилятором; обход по строкам идёт через прокси-кортежи
+// ссылок.
+template <typename... Fields>
+class soa_vector
+{
+	static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+	template <bool Const>
+	class basic_iterator
+	{
+		using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+	   public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = std::tuple<Fields...>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const,
+											 std::tuple<const Fields&...>,
+											 std::tuple<Fields&...>>;
+
+		basic_iterator() = default;
+
+		basic_iterator(owner* vec, size_t index) noexcept
+			: vec_(vec), index_(index)
+		{
+		}
+
+		reference operator*() const { return (*vec_)[index_]; }
+
+		reference operator[](difference_type n) const
+		{
+			return (*vec_)[index_ + n];
+		}
+
+		basic_iterator& operator++() noexcept
+		{
+			++index_;
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			--index_;
+			return *this;
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			index_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			index_ -= n;
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator+(difference_type n,
+										basic_iterator it) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.index_) -
+				   static_cast<difference_type>(rhs.index_);
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ == rhs.index_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.index_ <=> rhs.index_;
+		}
+
+	   private:
+		owner* vec_ = nullptr;
+		size_t index_ = 0;
+	};
+
+   public:
+	using value_type = std::tuple<Fields...>;
+	using reference = std::tuple<Fields&...>;
+	using const_reference = std::tuple<const Fields&...>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	template <size_t I>
+	using field_type = std::tuple_element_t<I, value_type>;
+
+	soa_vector() = default;
+
+	size_t size() const noexcept { return std::get<0>(columns_).size(); }
+
+	bool empty() const noexcept { return size() == 0; }
+
+	size_t capacity() const noexcept
+	{
+		return std::get<0>(columns_).capacity();
+	}
+
+	void reserve(size_t new_cap)
+	{
+		std::apply([new_cap](auto&... col) { (col.reserve(new_cap), ...); },
+				   columns_);
+	}
+
+	// Если рост одной из колонок бросает, все колонки возвращаются к
+	// прежней длине.
+	void resize(size_t new_size)
+	{
+		const size_t old_size = size();
+		try
+		{
+			std::apply([new_size](auto&... col)
+					   { (col.resize(new_size), ...); },
+					   columns_);
+		}
+		catch (...)
+		{
+			truncate_(old_size);
+			throw;
+		}
+	}
+
+	void clear() noexcept
+	{
+		std::apply([](auto&... col) { (col.clear(), ...); }, columns_);
+	}
+
+	template <typename... Args>
+	void push_back(Args&&... values)
+	{
+		static_assert(sizeof...(Args) == sizeof...(Fields),
+					  "push_back takes one value per field");
+		push_back_(std::index_sequence_for<Fields...>{},
+				   std::forward<Args>(values)...);
+	}
+
+	void pop_back()
+	{
+		std::apply([](auto&... col) { (col.pop_back(), ...); }, columns_);
+	}
+
+	reference operator[](size_t index) noexcept
+	{
+		return row_(index, std::index_sequence_for<Fields...>{});
+	}
+
+	const_reference operator[](size_t index) const noexcept
+	{
+		return row_(index, std::index_sequence_for<Fields...>{});
+	}
+
+	reference at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	const_reference at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	// Непрерывная колонка одного поля.
+	template <size_t I>
+	std::span<field_type<I>> column() noexcept
+	{
+		auto& col = std::get<I>(columns_);
+		return {col.data(), col.size()};
+	}
+
+	template <size_t I>
+	std::span<const field_type<I>> column() const noexcept
+	{
+		const auto& col = std::get<I>(columns_);
+		return {col.data(), col.size()};
+	}
+
+	iterator begin() noexcept { return iterator(this, 0); }
+
+	iterator end() noexcept { return iterator(this, size()); }
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, size());
+	}
+
+	void swap(soa_vector& other) noexcept { columns_.swap(other.columns_); }
+
+	friend void swap(soa_vector& lhs, soa_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+	friend bool operator==(const soa_vector& lhs, const soa_vector& rhs)
+	{
+		return lhs.columns_ == rhs.columns_;
+	}
+
+   private:
+	// Колонки растут по очереди; если бросает k-я, первые k откатываются,
+	// иначе строки разъехались бы по длине.
+	template <size_t... I, typename... Args>
+	void push_back_(std::index_sequence<I...>, Args&&... values)
+	{
+		const size_t old_size = size();
+		try
+		{
+			(std::get<I>(columns_).push_back(
+				 field_type<I>(std::forward<Args>(values))),
+			 ...);
+		}
+		catch (...)
+		{
+			truncate_(old_size);
+			throw;
+		}
+	}
+
+	// Укорачивание simple_vector не выделяет память и не бросает.
+	void truncate_(size_t n) noexcept
+	{
+		std::apply(
+			[n](auto&... col)
+			{
+				((col.size() > n ? col.resize(n) : void()), ...);
+			},
+			columns_);
+	}
+
+	template <size_t... I>
+	reference row_(size_t index, std::index_sequence<I...>) noexcept
+	{
+		return reference(std::get<I>(columns_)[index]...);
+	}
+
+	template <size_t... I>
+	const_reference row_(size_t index, std::index_sequence<I...>) const noexcept
+	{
+		return const_reference(std::get<I>(columns_)[index]...);
+	}
+
+	std::tuple<simple_vector<Fields>...> columns_;
+};
+}  // namespace bmstu
@@ -0,0 +1,180 @@
+#include "soa_vector.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "base_algo_let.h"
+
+TEST(SoaVector, DefaultConstructor)
+{
+	bmstu::soa_vector<uint8_t, std::string> v;
+	ASSERT_EQ(v.size(), 0u);
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.begin(), v.end());
+}
+
+TEST(SoaVector, PushBackAndIndex)
+{
+	bmstu::soa_vector<int, std::string, double> v;
+	v.push_back(1, "one", 1.5);
+	v.push_back(2, "two", 2.5);
+	ASSERT_EQ(v.size(), 2u);
+
+	auto [id, name, weight] = v[1];
+	ASSERT_EQ(id, 2);
+	ASSERT_EQ(name, "two");
+	ASSERT_EQ(weight, 2.5);
+
+	std::get<1>(v[0]) = "uno";
+	ASSERT_EQ(std::get<1>(v.at(0)), "uno");
+	ASSERT_THROW(v.at(2), std::out_of_range);
+}
+
+TEST(SoaVector, ColumnsAreContiguous)
+{
+	bmstu::soa_vector<int, char> v;
+	for (int i = 0; i < 100; ++i)
+	{
+		v.push_back(i, static_cast<char>('a' + i % 26));
+	}
+	auto ids = v.column<0>();
+	ASSERT_EQ(ids.size(), 100u);
+	for (size_t i = 1; i < ids.size(); ++i)
+	{
+		ASSERT_EQ(&ids[i], &ids[i - 1] + 1);
+	}
+	for (int& id : ids)
+	{
+		id *= 2;
+	}
+	ASSERT_EQ(std::get<0>(v[10]), 20);
+	ASSERT_EQ(v.column<1>()[27], 'b');
+}
+
+TEST(SoaVector, RowIteration)
+{
+	bmstu::soa_vector<int, std::string> v;
+	v.push_back(3, "c");
+	v.push_back(1, "a");
+	v.push_back(2, "b");
+
+	std::string joined;
+	int sum = 0;
+	for (auto [id, name] : v)
+	{
+		sum += id;
+		joined += name;
+	}
+	ASSERT_EQ(sum, 6);
+	ASSERT_EQ(joined, "cab");
+
+	for (auto [id, name] : v)
+	{
+		name += "!";
+	}
+	ASSERT_EQ(std::get<1>(v[2]), "b!");
+
+	const auto& cv = v;
+	auto it = std::find_if(cv.begin(), cv.end(),
+						   [](auto row) { return std::get<0>(row) == 1; });
+	ASSERT_EQ(it - cv.begin(), 1);
+}
+
+TEST(SoaVector, PopBackClearCompare)
+{
+	bmstu::soa_vector<int, int> a;
+	bmstu::soa_vector<int, int> b;
+	a.push_back(1, 2);
+	a.push_back(3, 4);
+	b.push_back(1, 2);
+	ASSERT_FALSE(a == b);
+	a.pop_back();
+	ASSERT_TRUE(a == b);
+	a.clear();
+	ASSERT_TRUE(a.empty());
+}
+
+namespace
+{
+// Бросает при построении по требованию: и из int, и по умолчанию.
+struct fragile_field
+{
+	static inline bool fail = false;
+
+	fragile_field() { check(); }
+
+	fragile_field(int v) : value(v) { check(); }
+
+	static void check()
+	{
+		if (fail)
+		{
+			throw std::runtime_error("field construction failed");
+		}
+	}
+
+	int value = 0;
+};
+}  // namespace
+
+TEST(SoaVector, FailedGrowthKeepsColumnsAligned)
+{
+	bmstu::soa_vector<int, fragile_field> v;
+	v.push_back(1, 10);
+	fragile_field::fail = true;
+	ASSERT_THROW(v.push_back(2, 20), std::runtime_error);
+	ASSERT_EQ(v.size(), 1u);
+	ASSERT_EQ(v.column<0>().size(), 1u);
+	ASSERT_EQ(v.column<1>().size(), 1u);
+
+	ASSERT_THROW(v.resize(100), std::runtime_error);
+	ASSERT_EQ(v.column<0>().size(), 1u);
+	ASSERT_EQ(v.column<1>().size(), 1u);
+	fragile_field::fail = false;
+
+	v.push_back(3, 30);
+	ASSERT_EQ(std::get<0>(v[1]), 3);
+	ASSERT_EQ(std::get<1>(v[1]).value, 30);
+}
+
+TEST(SoaVectorBench, DISABLED_AgeFilterScan)
+{
+	constexpr size_t kCount = 10'000'000;
+	std::vector<Student> aos;
+	aos.reserve(kCount);
+	bmstu::soa_vector<uint8_t, std::string> soa;
+	soa.reserve(kCount);
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		const int age = 16 + static_cast<int>(i * 7919 % 15);
+		aos.emplace_back("student", age);
+		soa.push_back(static_cast<uint8_t>(age), "student");
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	size_t aos_adults = 0;
+	for (const Student& s : aos)
+	{
+		aos_adults += s.age >= 18;
+	}
+	const std::chrono::duration<double, std::milli> aos_time =
+		std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	size_t soa_adults = 0;
+	for (uint8_t age : soa.column<0>())
+	{
+		soa_adults += age >= 18;
+	}
+	const std::chrono::duration<double, std::milli> soa_time =
+		std::chrono::steady_clock::now() - start;
+
+	ASSERT_EQ(aos_adults, soa_adults);
+	std::cout << "AoS scan: " << aos_time.count()
+			  << " ms, SoA scan: " << soa_time.count() << " ms\n";
+}
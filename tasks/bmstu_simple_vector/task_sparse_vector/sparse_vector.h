@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "bit_vector.h"
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Разреженный вектор: логически size() элементов, но хранятся только
+// значения, отличные от значения по умолчанию. Битовая карта отмечает
+// занятые позиции, сами значения лежат подряд в порядке индексов. Индекс
+// значения — rank(позиции): число единиц до неё. Для rank на каждые 512 бит
+// хранится накопленный счётчик, поэтому доступ — O(1): счётчик блока плюс
+// не больше восьми popcount.
+template <typename T>
+class sparse_vector
+{
+   public:
+	static constexpr size_t bits_per_block = 512;
+
+	explicit sparse_vector(size_t size = 0, T default_value = T{})
+		: bits_(size), default_(std::move(default_value))
+	{
+		rebuild_ranks_();
+	}
+
+	// Сжимает плотный вектор за один проход.
+	static sparse_vector from_dense(const simple_vector<T>& dense,
+									T default_value = T{})
+	{
+		sparse_vector result(0, std::move(default_value));
+		result.bits_.reserve(dense.size());
+		for (const T& value : dense)
+		{
+			result.push_back(value);
+		}
+		return result;
+	}
+
+	simple_vector<T> to_dense() const
+	{
+		simple_vector<T> dense(size(), default_);
+		for_each_non_default([&dense](size_t index, const T& value)
+							 { dense[index] = value; });
+		return dense;
+	}
+
+	size_t size() const noexcept { return bits_.size(); }
+
+	bool empty() const noexcept { return bits_.empty(); }
+
+	// Сколько значений хранится явно.
+	size_t non_default_count() const noexcept { return values_.size(); }
+
+	const T& default_value() const noexcept { return default_; }
+
+	// Байты под карту, индекс rank и значения.
+	size_t memory_bytes() const noexcept
+	{
+		return bits_.memory_bytes() + ranks_.capacity() * sizeof(uint64_t) +
+			   values_.capacity() * sizeof(T);
+	}
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return bits_[index] ? values_[rank(index)] : default_;
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return (*this)[index];
+	}
+
+	bool contains(size_t index) const noexcept
+	{
+		return index < size() && bits_[index];
+	}
+
+	// Число явно хранимых значений с позициями меньше index.
+	size_t rank(size_t index) const noexcept
+	{
+		const size_t block = index / bits_per_block;
+		const uint64_t* words = bits_.words();
+		size_t result = ranks_[block];
+		const size_t last_word = index / bit_vector::bits_per_word;
+		for (size_t w = block * words_per_block_; w < last_word; ++w)
+		{
+			result += std::popcount(words[w]);
+		}
+		const size_t tail = index % bit_vector::bits_per_word;
+		if (tail != 0)
+		{
+			result += std::popcount(words[last_word] &
+									((uint64_t{1} << tail) - 1));
+		}
+		return result;
+	}
+
+	// Позиция k-го явно хранимого значения (k < non_default_count()).
+	size_t select(size_t k) const noexcept
+	{
+		const size_t block =
+			std::upper_bound(ranks_.begin(), ranks_.end(), k) - ranks_.begin() -
+			1;
+		k -= ranks_[block];
+		const uint64_t* words = bits_.words();
+		for (size_t w = block * words_per_block_;; ++w)
+		{
+			uint64_t bits = words[w];
+			const size_t ones = std::popcount(bits);
+			if (k < ones)
+			{
+				for (; k > 0; --k)
+				{
+					bits &= bits - 1;
+				}
+				return w * bit_vector::bits_per_word + std::countr_zero(bits);
+			}
+			k -= ones;
+		}
+	}
+
+	std::span<const T> values() const noexcept
+	{
+		return {values_.data(), values_.size()};
+	}
+
+	// Вызывает f(index, value) для каждого значения не по умолчанию.
+	template <typename F>
+	void for_each_non_default(F f) const
+	{
+		size_t k = 0;
+		bits_.for_each_set([&](size_t index) { f(index, values_[k++]); });
+	}
+
+	// Запись в середину сдвигает хранимые значения: O(non_default_count()).
+	void set(size_t index, T value)
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		const size_t k = rank(index);
+		if (bits_[index])
+		{
+			if (value == default_)
+			{
+				values_.erase(values_.cbegin() + k);
+				bits_[index] = false;
+				shift_ranks_(index, -1);
+			}
+			else
+			{
+				values_[k] = std::move(value);
+			}
+		}
+		else if (!(value == default_))
+		{
+			values_.insert(values_.cbegin() + k, std::move(value));
+			bits_[index] = true;
+			shift_ranks_(index, 1);
+		}
+	}
+
+	void reset(size_t index) { set(index, default_); }
+
+	void push_back(T value)
+	{
+		const bool present = !(value == default_);
+		if (present)
+		{
+			values_.push_back(std::move(value));
+		}
+		bits_.push_back(present);
+		if (size() % bits_per_block == 0)
+		{
+			ranks_.push_back(values_.size());
+		}
+	}
+
+	void resize(size_t new_size)
+	{
+		if (new_size < size())
+		{
+			values_.resize(rank(new_size));
+		}
+		bits_.resize(new_size);
+		rebuild_ranks_();
+	}
+
+	void clear() noexcept
+	{
+		bits_.clear();
+		values_.clear();
+		ranks_.clear();
+		ranks_.push_back(0);
+	}
+
+	friend bool operator==(const sparse_vector& lhs, const sparse_vector& rhs)
+	{
+		return lhs.default_ == rhs.default_ && lhs.bits_ == rhs.bits_ &&
+			   lhs.values_ == rhs.values_;
+	}
+
+   private:
+	static constexpr size_t words_per_block_ =
+		bits_per_block / bit_vector::bits_per_word;
+
+	// ranks_[b] — число единиц до бита b * bits_per_block;
+	// ranks_.size() == size() / bits_per_block + 1.
+	void rebuild_ranks_()
+	{
+		ranks_.clear();
+		ranks_.reserve(size() / bits_per_block + 1);
+		const uint64_t* words = bits_.words();
+		const size_t word_count = bits_.word_count();
+		size_t total = 0;
+		ranks_.push_back(0);
+		for (size_t w = 0; w + words_per_block_ <= word_count &&
+						   ranks_.size() <= size() / bits_per_block;
+			 w += words_per_block_)
+		{
+			for (size_t i = 0; i < words_per_block_; ++i)
+			{
+				total += std::popcount(words[w + i]);
+			}
+			ranks_.push_back(total);
+		}
+	}
+
+	void shift_ranks_(size_t index, int delta) noexcept
+	{
+		for (size_t b = index / bits_per_block + 1; b < ranks_.size(); ++b)
+		{
+			ranks_[b] += delta;
+		}
+	}
+
+	bit_vector bits_;
+	simple_vector<T> values_;
+	simple_vector<uint64_t> ranks_;
+	T default_;
+};
+}  // namespace bmstu
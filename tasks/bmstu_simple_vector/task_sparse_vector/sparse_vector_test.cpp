@@ -0,0 +1,184 @@
+#include "sparse_vector.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bench.h"
+
+TEST(SparseVector, DefaultsEverywhere)
+{
+	bmstu::sparse_vector<int> v(1000);
+	ASSERT_EQ(v.size(), 1000u);
+	ASSERT_EQ(v.non_default_count(), 0u);
+	ASSERT_EQ(v[0], 0);
+	ASSERT_EQ(v[999], 0);
+	ASSERT_THROW(v.at(1000), std::out_of_range);
+
+	bmstu::sparse_vector<std::string> words(10, "none");
+	ASSERT_EQ(words[3], "none");
+}
+
+TEST(SparseVector, SetAndReset)
+{
+	bmstu::sparse_vector<int> v(2000);
+	v.set(1500, 15);
+	v.set(3, 3);
+	v.set(700, 7);
+	ASSERT_EQ(v.non_default_count(), 3u);
+	ASSERT_EQ(v[3], 3);
+	ASSERT_EQ(v[700], 7);
+	ASSERT_EQ(v[1500], 15);
+	ASSERT_EQ(v[1499], 0);
+	ASSERT_TRUE(v.contains(700));
+
+	v.set(700, 70);
+	ASSERT_EQ(v[700], 70);
+	ASSERT_EQ(v.non_default_count(), 3u);
+	v.set(700, 0);
+	ASSERT_FALSE(v.contains(700));
+	ASSERT_EQ(v[1500], 15);
+	v.reset(3);
+	ASSERT_EQ(v.non_default_count(), 1u);
+	ASSERT_EQ(v.rank(1500), 0u);
+	ASSERT_THROW(v.set(2000, 1), std::out_of_range);
+}
+
+TEST(SparseVector, RankAndSelect)
+{
+	bmstu::sparse_vector<int> v(5000);
+	std::vector<size_t> positions;
+	for (size_t i = 7; i < 5000; i += 37)
+	{
+		v.set(i, static_cast<int>(i));
+		positions.push_back(i);
+	}
+	for (size_t k = 0; k < positions.size(); ++k)
+	{
+		ASSERT_EQ(v.select(k), positions[k]);
+		ASSERT_EQ(v.rank(positions[k]), k);
+	}
+	ASSERT_EQ(v.rank(v.size()), positions.size());
+}
+
+TEST(SparseVector, IterateNonDefault)
+{
+	bmstu::sparse_vector<double> v(100000, -1.0);
+	v.set(99999, 2.0);
+	v.set(5, 1.0);
+	std::vector<std::pair<size_t, double>> seen;
+	v.for_each_non_default([&seen](size_t index, double value)
+						   { seen.emplace_back(index, value); });
+	ASSERT_EQ(seen, (std::vector<std::pair<size_t, double>>{{5, 1.0},
+															 {99999, 2.0}}));
+	ASSERT_EQ(v.values().size(), 2u);
+}
+
+TEST(SparseVector, DenseRoundTrip)
+{
+	std::mt19937 gen(11);
+	bmstu::simple_vector<int> dense(20000);
+	for (int& x : dense)
+	{
+		x = gen() % 50 == 0 ? static_cast<int>(gen() % 1000) + 1 : 0;
+	}
+	const auto sparse = bmstu::sparse_vector<int>::from_dense(dense);
+	ASSERT_EQ(sparse.size(), dense.size());
+	for (size_t i = 0; i < dense.size(); ++i)
+	{
+		ASSERT_EQ(sparse[i], dense[i]);
+	}
+	ASSERT_EQ(sparse.to_dense(), dense);
+
+	bmstu::sparse_vector<int> built(dense.size());
+	for (size_t i = 0; i < dense.size(); ++i)
+	{
+		built.set(i, dense[i]);
+	}
+	ASSERT_EQ(built, sparse);
+}
+
+TEST(SparseVector, PushBackAndResize)
+{
+	bmstu::sparse_vector<int> v;
+	for (int i = 0; i < 3000; ++i)
+	{
+		v.push_back(i % 100 == 0 ? i + 1 : 0);
+	}
+	ASSERT_EQ(v.non_default_count(), 30u);
+	ASSERT_EQ(v[2900], 2901);
+	v.resize(1001);
+	ASSERT_EQ(v.non_default_count(), 11u);
+	ASSERT_EQ(v[1000], 1001);
+	v.resize(4000);
+	ASSERT_EQ(v[3000], 0);
+	v.set(3999, 1);
+	ASSERT_EQ(v.select(11), 3999u);
+	v.clear();
+	ASSERT_TRUE(v.empty());
+	ASSERT_EQ(v.non_default_count(), 0u);
+}
+
+using bmstu::bench::measure_ms;
+
+TEST(SparseVectorBench, DISABLED_MemoryAndRandomAccess)
+{
+	constexpr size_t kSlots = 100'000'000;
+	constexpr size_t kReads = 10'000'000;
+	std::mt19937_64 gen(5);
+	bmstu::sparse_vector<double> sparse;
+	for (size_t i = 0; i < kSlots; ++i)
+	{
+		sparse.push_back(gen() % 100 == 0 ? 1.0 + (i % 7) : 0.0);
+	}
+	const bmstu::simple_vector<double> dense = sparse.to_dense();
+	bmstu::simple_vector<size_t> probes(kReads);
+	for (size_t& probe : probes)
+	{
+		probe = gen() % kSlots;
+	}
+
+	double dense_sum = 0;
+	double sparse_sum = 0;
+	const double dense_ms = measure_ms(
+		[&]
+		{
+			for (size_t probe : probes)
+			{
+				dense_sum += dense[probe];
+			}
+		});
+	const double sparse_ms = measure_ms(
+		[&]
+		{
+			for (size_t probe : probes)
+			{
+				sparse_sum += sparse[probe];
+			}
+		});
+	ASSERT_EQ(dense_sum, sparse_sum);
+
+	double scan_sum = 0;
+	const double scan_ms = measure_ms(
+		[&]
+		{
+			sparse.for_each_non_default([&scan_sum](size_t, double value)
+										{ scan_sum += value; });
+		});
+	ASSERT_EQ(scan_sum, std::accumulate(sparse.values().begin(),
+										sparse.values().end(), 0.0));
+
+	std::cout << "slots " << kSlots << ", non-default "
+			  << sparse.non_default_count() << "\n";
+	std::cout << "memory: simple_vector "
+			  << dense.capacity() * sizeof(double) / (1 << 20)
+			  << " MiB, sparse_vector " << sparse.memory_bytes() / (1 << 20)
+			  << " MiB\n";
+	std::cout << "random read: simple_vector " << dense_ms * 1e6 / kReads
+			  << " ns, sparse_vector " << sparse_ms * 1e6 / kReads << " ns\n";
+	std::cout << "scan non-default: " << scan_ms << " ms\n";
+}